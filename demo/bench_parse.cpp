@@ -0,0 +1,51 @@
+// SPDX-License-Identifier:  MIT
+// Copyright (C) 2020-2022 - csbiginteger-cpp project
+
+// benchmark: decimal parsing BigInteger(str, 10) for several input sizes
+// usage: ./bench_parse [total_digits=20000000]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <csbiginteger/BigInteger.h>
+
+using namespace csbiginteger;  // NOLINT
+
+int main(int argc, char** argv) {
+  size_t total = argc > 1 ? std::atol(argv[1]) : 20000000;
+  std::cout << "engine: " << BigInteger::getEngine() << std::endl;
+  for (size_t digits : {8, 19, 40, 100, 1000, 10000, 100000, 1000000}) {
+    // distinct inputs, so nothing is cached
+    std::vector<std::string> inputs;
+    for (int k = 0; k < 16; k++) {
+      std::string s(digits, '0');
+      for (size_t i = 0; i < digits; i++) s[i] = '1' + (i * 7 + k) % 9;
+      inputs.push_back(s);
+    }
+    size_t reps = std::max<size_t>(1, total / digits);
+    size_t sink = 0;
+    // constructor (string copy and fresh storage on each call)
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < reps; r++)
+      sink += BigInteger(inputs[r % inputs.size()], 10).Length();
+    auto t1 = std::chrono::steady_clock::now();
+    // FromChars into reused value
+    BigInteger value;
+    for (size_t r = 0; r < reps; r++) {
+      const std::string& s = inputs[r % inputs.size()];
+      BigInteger::FromChars(s.data(), s.data() + s.size(), value);
+      sink += value.Length();
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    double ctor = std::chrono::duration<double>(t1 - t0).count();
+    double chars = std::chrono::duration<double>(t2 - t1).count();
+    std::cout << "digits: " << digits << "  BigInteger(str, 10): "
+              << (reps * digits) / ctor / 1e6
+              << " MB/s  FromChars: " << (reps * digits) / chars / 1e6
+              << " MB/s  (" << sink << ")" << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier:  MIT
+// Copyright (C) 2020-2022 - csbiginteger-cpp project
+
+// benchmark: global allocator vs per-transaction monotonic arena
+// usage: ./bench_pmr [threads=32] [transactions=2000] [ops=64]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+#include <csbiginteger/BigInteger.h>
+
+using namespace csbiginteger;  // NOLINT
+
+// one transaction: a few arithmetic steps over balances
+static BigInteger transaction(int ops, int seed) {
+  BigInteger acc(seed);
+  BigInteger fee("123456789012345678901234567890", 10);
+  for (int i = 0; i < ops; i++) {
+    BigInteger x = acc * BigInteger(i + 3) + fee;
+    acc = (x - fee) / BigInteger(i + 2);
+  }
+  return acc;
+}
+
+static double run(int nthreads, int ntx, int ops, bool arena) {
+  auto t0 = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  for (int t = 0; t < nthreads; t++) {
+    workers.emplace_back([=]() {
+      BigInteger total;
+      char buffer[16 * 1024];  // first chunk of arena lives on stack
+      for (int k = 0; k < ntx; k++) {
+        if (arena) {
+          std::pmr::monotonic_buffer_resource mono(buffer, sizeof(buffer));
+          BigInteger::MemoryResourceScope scope(&mono);
+          BigInteger r = transaction(ops, t + k);
+          // result escapes arena
+          total = BigInteger(r, std::pmr::new_delete_resource());
+        } else {
+          total = transaction(ops, t + k);
+        }
+      }
+    });
+  }
+  for (auto& w : workers) w.join();
+  auto t1 = std::chrono::steady_clock::now();
+  double secs = std::chrono::duration<double>(t1 - t0).count();
+  return (static_cast<double>(nthreads) * ntx * ops) / secs;
+}
+
+int main(int argc, char** argv) {
+  int nthreads = argc > 1 ? std::atoi(argv[1]) : 32;
+  int ntx = argc > 2 ? std::atoi(argv[2]) : 2000;
+  int ops = argc > 3 ? std::atoi(argv[3]) : 64;
+
+  std::cout << "engine: " << BigInteger::getEngine() << " threads: " << nthreads
+            << " transactions/thread: " << ntx << " ops/transaction: " << ops
+            << std::endl;
+  double global = run(nthreads, ntx, ops, false);
+  std::cout << "global allocator: " << global << " ops/s" << std::endl;
+  double arena = run(nthreads, ntx, ops, true);
+  std::cout << "monotonic arena:  " << arena << " ops/s" << std::endl;
+  return 0;
+}
@@ -0,0 +1,259 @@
+// SPDX-License-Identifier:  MIT
+// Copyright (C) 2020-2022 - csbiginteger-cpp project
+
+// csbig-calc: batch calculator over newline-delimited operations
+// usage: ./csbig-calc [-j threads] [file ...]   (stdin when no file given)
+//
+// each line: <op> <number> [<number>], ops as cs_demo:
+//   + - / * % ^ (two numbers, decimal result)
+//   > < (two numbers, 1 or 0)
+//   0x 0b (one number, ToString(16) or ToString(2))
+// numbers are decimal (optional '-') or unsigned hex with prefix 0x.
+// one output line per input line, same order ("error" for invalid lines,
+// blank lines are skipped). throughput is reported on stderr.
+//
+// input is read in blocks of ~1 MB (grown to hold longer lines); each block
+// is evaluated on 'threads' workers (one slice of lines each, own output
+// buffer) while the next block is read, and slices are written in order
+// through a buffered writer.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <csbiginteger/BigInteger.h>
+#include <csbiginteger/Reduction.hpp>
+
+using namespace csbiginteger;  // NOLINT
+
+constexpr size_t BLOCK = size_t{1} << 20;  // bytes read per block
+constexpr int TO_CHARS_BYTES = 1024;  // larger results use engine ToString
+
+// number token: decimal, or unsigned hex with prefix 0x
+static BigInteger parseNumber(std::string_view s) {
+  if ((s.size() > 2) && (s[0] == '0') && (s[1] == 'x'))
+    return BigInteger::Parse(s.substr(2), 16);
+  return BigInteger::Parse(s);
+}
+
+// appends decimal digits of 'big' ("error" for Error())
+static void appendDecimal(const BigInteger& big, std::string& out) {
+  if (big.Length() > TO_CHARS_BYTES) {
+    out += big.ToString(10);  // engine conversion (subquadratic)
+    return;
+  }
+  size_t old = out.size();
+  out.resize(old + 2 + (8 * static_cast<size_t>(big.Length()) + 2) / 3);
+  std::to_chars_result r = big.ToChars(&out[old], &out[0] + out.size());
+  if (r.ec != std::errc()) {
+    out.resize(old);
+    out += "error";
+    return;
+  }
+  out.resize(r.ptr - &out[0]);
+}
+
+// evaluates one line, appending its output line (nothing for blank lines)
+static void evaluate(std::string_view line, std::string& out) {
+  std::string_view tok[4];
+  size_t n = 0;
+  for (size_t i = 0; i < line.size();) {
+    while ((i < line.size()) && ((line[i] == ' ') || (line[i] == '\t') ||
+                                 (line[i] == '\r')))
+      i++;
+    size_t start = i;
+    while ((i < line.size()) && (line[i] != ' ') && (line[i] != '\t') &&
+           (line[i] != '\r'))
+      i++;
+    if (i == start) break;
+    if (n == 4) {
+      n = 0;  // too many tokens
+      break;
+    }
+    tok[n++] = line.substr(start, i - start);
+  }
+  if ((n == 0) && (line.find_first_not_of(" \t\r") == std::string_view::npos))
+    return;
+  std::string_view op = (n > 0) ? tok[0] : std::string_view();
+  bool unary = (op == "0x") || (op == "0b");
+  BigInteger a = (n > 1) ? parseNumber(tok[1]) : BigInteger::Error();
+  BigInteger b = (n > 2) ? parseNumber(tok[2]) : BigInteger::Error();
+  if ((n != (unary ? 2u : 3u)) || a.IsError() || (!unary && b.IsError())) {
+    out += "error\n";
+    return;
+  }
+  if (op == "+") {
+    appendDecimal(a + b, out);
+  } else if (op == "-") {
+    appendDecimal(a - b, out);
+  } else if (op == "*") {
+    appendDecimal(a * b, out);
+  } else if (op == "/") {
+    appendDecimal(a / b, out);
+  } else if (op == "%") {
+    appendDecimal(a % b, out);
+  } else if (op == "^") {
+    cs_int64 e;
+    bool ok = b.TryToInt64(e) && (e >= 0) && (e <= (1 << 30));
+    appendDecimal(ok ? BigInteger::Pow(a, static_cast<cs_int32>(e))
+                     : BigInteger::Error(),
+                  out);
+  } else if (op == ">") {
+    out += (a > b) ? "1" : "0";
+  } else if (op == "<") {
+    out += (a < b) ? "1" : "0";
+  } else if (op == "0x") {
+    out += a.ToString(16);
+  } else if (op == "0b") {
+    out += a.ToString(2);
+  } else {
+    out += "error";
+  }
+  out += '\n';
+}
+
+// buffered reader over several files (stdin when empty): whole lines only
+class LineReader {
+ public:
+  explicit LineReader(std::vector<const char*> files) : files(files) {
+    if (this->files.empty()) this->files.push_back(nullptr);
+  }
+
+  ~LineReader() {
+    if ((in != nullptr) && (in != stdin)) std::fclose(in);
+  }
+
+  // next block of whole lines (empty at end only). false on open error
+  bool next(std::string& block) {
+    block.swap(tail);
+    tail.clear();
+    size_t end = std::string::npos;  // after last '\n' (tail has none)
+    // at least BLOCK bytes, grown until one whole line (lines may be longer)
+    while ((block.size() < BLOCK) || (end == std::string::npos)) {
+      if ((in == nullptr) && !open()) return false;
+      if (in == nullptr) break;  // no more files
+      size_t old = block.size();
+      block.resize(old + BLOCK);
+      size_t got = std::fread(&block[old], 1, BLOCK, in);
+      block.resize(old + got);
+      size_t nl = std::string_view(block).substr(old).rfind('\n');
+      if (nl != std::string_view::npos) end = old + nl + 1;
+      if (got == 0) {
+        if (in != stdin) std::fclose(in);
+        in = nullptr;
+        if (!block.empty() && (block.back() != '\n')) block += '\n';
+        if (!block.empty()) end = block.size();
+      }
+    }
+    // keep partial last line for next block
+    if (end == std::string::npos) end = 0;  // no input left
+    tail.assign(block, end, std::string::npos);
+    block.resize(end);
+    return true;
+  }
+
+  // bytes of input handed out so far
+  void count(size_t n) { total += n; }
+
+  size_t bytes() const { return total; }
+
+ private:
+  std::vector<const char*> files;
+  size_t file{0};
+  std::FILE* in{nullptr};
+  std::string tail;
+  size_t total{0};
+
+  // opens next file (in stays nullptr when all were consumed)
+  bool open() {
+    if (file == files.size()) return true;
+    const char* name = files[file++];
+    in = (name == nullptr) ? stdin : std::fopen(name, "rb");
+    if (in == nullptr) {
+      std::fprintf(stderr, "csbig-calc: cannot open '%s'\n", name);
+      return false;
+    }
+    std::setvbuf(in, nullptr, _IOFBF, BLOCK);
+    return true;
+  }
+};
+
+// evaluates all lines of 'block' on 'nthreads' slices, returns outputs in
+// line order (one buffer per slice)
+static std::vector<std::string> evaluateBlock(const std::string& block,
+                                              unsigned nthreads,
+                                              size_t& lines) {
+  std::vector<std::string_view> views;
+  for (size_t i = 0; i < block.size();) {
+    size_t end = block.find('\n', i);
+    views.emplace_back(block.data() + i, end - i);
+    i = end + 1;
+  }
+  lines = views.size();
+  nthreads = std::max(1u, std::min<unsigned>(
+                              nthreads, static_cast<unsigned>(views.size())));
+  std::vector<std::string> outs(nthreads);
+  ReductionParts(views.begin(), views.size(), nthreads,
+                 [&outs](std::vector<std::string_view>::iterator begin,
+                         std::vector<std::string_view>::iterator end,
+                         unsigned t) {
+                   for (auto it = begin; it != end; ++it)
+                     evaluate(*it, outs[t]);
+                 });
+  return outs;
+}
+
+int main(int argc, char** argv) {
+  unsigned nthreads = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<const char*> files;
+  for (int i = 1; i < argc; i++) {
+    if ((std::strcmp(argv[i], "-j") == 0) && (i + 1 < argc))
+      nthreads = std::max(1, std::atoi(argv[++i]));
+    else
+      files.push_back(argv[i]);
+  }
+  auto t0 = std::chrono::steady_clock::now();
+  LineReader reader(files);
+  std::string block, next;
+  if (!reader.next(block)) return 1;
+  std::string outbuf;
+  size_t lines = 0;
+  bool ok = true;
+  while (!block.empty()) {
+    reader.count(block.size());
+    size_t n = 0;
+    // evaluate current block while next one is read
+    auto work = std::async(std::launch::async, [&block, nthreads, &n]() {
+      return evaluateBlock(block, nthreads, n);
+    });
+    ok = reader.next(next);
+    for (const std::string& out : work.get()) {
+      outbuf += out;
+      if (outbuf.size() >= BLOCK) {
+        std::fwrite(outbuf.data(), 1, outbuf.size(), stdout);
+        outbuf.clear();
+      }
+    }
+    lines += n;
+    if (!ok) break;
+    block.swap(next);
+  }
+  std::fwrite(outbuf.data(), 1, outbuf.size(), stdout);
+  std::fflush(stdout);
+  double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                              t0)
+                    .count();
+  std::fprintf(stderr,
+               "csbig-calc: %zu lines, %.1f MB in %.3f s (%.0f lines/s, "
+               "%.1f MB/s, %u threads, engine %s)\n",
+               lines, reader.bytes() / 1e6, secs, lines / secs,
+               reader.bytes() / 1e6 / secs, nthreads,
+               BigInteger::getEngine().c_str());
+  return ok ? 0 : 1;
+}
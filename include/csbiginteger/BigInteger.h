@@ -13,14 +13,24 @@
 #include <sstream>
 #include <vector>
 */
-#include <algorithm>  // std::copy
-#include <memory>     // unique_ptr
-#include <sstream>    // stringstream
+#include <algorithm>        // std::copy
+#include <charconv>         // to_chars_result
+#include <cmath>            // ldexp
+#include <future>           // async
+#include <iterator>         // distance
+#include <limits>
+#include <memory_resource>  // pmr
+#include <ostream>
+#include <sstream>          // stringstream
 #include <string>
+#include <string_view>
+#include <system_error>  // errc
 #include <utility>
 
 // internal classes
+#include <csbiginteger/BigIntegerStringCache.hpp>
 #include <csbiginteger/Helper.hpp>
+#include <csbiginteger/Limbs.hpp>
 
 // original specification:
 // https://referencesource.microsoft.com/#System.Numerics/System/Numerics/BigInteger.cs
@@ -37,11 +47,62 @@ class BigInteger final {
   // efficiency is not important at this moment, correctness and portability is!
   // TODO(igormcoelho): perhaps it's better to store in little-endian format...
   // see which methods are affected.
-  cs_vbyte _data;
+  // storage comes from the thread memory resource (see MemoryResourceScope)
+  cs_pmr_vbyte _data{GetThreadMemoryResource()};
+
+  // memory resource for new BigInteger storage on this thread (nullptr means
+  // std::pmr::get_default_resource())
+  static inline thread_local std::pmr::memory_resource* _threadResource =
+      nullptr;
+
+  // replace internal bytes (big-endian) keeping current memory resource
+  void setData(const cs_vbyte& data) { _data.assign(data.begin(), data.end()); }
+
+  // reads and writes magnitudes straight from bytes (limb kernel)
+  friend class BigIntegerDivisor;
 
  public:
   static std::string getEngine();
 
+  // operand cache of engine, for the calling thread (GMP keeps recent
+  // operands as prebuilt mpz_t). false when engine has none
+  static bool OperandCacheStats(cs_uint64& hits, cs_uint64& misses);
+
+  // memory resource used by every BigInteger created on the calling thread
+  static std::pmr::memory_resource* GetThreadMemoryResource() {
+    return _threadResource ? _threadResource : std::pmr::get_default_resource();
+  }
+
+  // returns previous resource (nullptr restores default behavior)
+  static std::pmr::memory_resource* SetThreadMemoryResource(
+      std::pmr::memory_resource* res) {
+    std::pmr::memory_resource* old = _threadResource;
+    _threadResource = res;
+    return old;
+  }
+
+  // memory resource holding this BigInteger storage
+  std::pmr::memory_resource* GetMemoryResource() const {
+    return _data.get_allocator().resource();
+  }
+
+  // RAII helper: all BigInteger created on this thread (including engine
+  // results and temporaries) use 'res' while scope is alive.
+  // Values that outlive 'res' must be copied out with
+  // BigInteger(big, std::pmr::new_delete_resource()) before it is released.
+  class MemoryResourceScope final {
+   private:
+    std::pmr::memory_resource* _old;
+
+   public:
+    explicit MemoryResourceScope(std::pmr::memory_resource* res)
+        : _old(SetThreadMemoryResource(res)) {}
+    ~MemoryResourceScope() { SetThreadMemoryResource(_old); }
+
+    MemoryResourceScope(const MemoryResourceScope&) = delete;
+    MemoryResourceScope& operator=(const MemoryResourceScope&) = delete;
+  };
+
   // size in bytes
   int Length() const { return _data.size(); }
 
@@ -50,50 +111,55 @@ class BigInteger final {
   bool CopyTo(cs_byte* vr, int sz_vr) const {
     // check if size is enough
     if (sz_vr < Length()) return false;
-    cs_vbyte data = _data;                   // big-endian
-    std::reverse(data.begin(), data.end());  // to little-endian
-    std::copy(data.begin(), data.end(), vr);
+    std::reverse_copy(_data.begin(), _data.end(), vr);  // to little-endian
     return true;
   }
 
   static const BigInteger getMin;  // get?
   //
 
-  // used for global caching
-  static inline std::unique_ptr<BigInteger> _One;
-  static inline std::unique_ptr<BigInteger> _Zero;
-  static inline std::unique_ptr<BigInteger> _MinusOne;
-  static inline std::unique_ptr<BigInteger> _Error;
-
+  // used for global caching (always on new_delete_resource, never on an
+  // arena). function-local statics are initialized once, thread-safely, so
+  // workers may hit them first (they are never destroyed, as before)
   static const BigInteger One() {
-    if (!_One) _One = std::unique_ptr<BigInteger>(new BigInteger(1));
-    return *_One;
+    static const BigInteger* p =
+        new BigInteger(BigInteger(1), std::pmr::new_delete_resource());
+    return *p;
   }
   static const BigInteger Zero() {
-    if (!_Zero) _Zero = std::unique_ptr<BigInteger>(new BigInteger(0));
-    return *_Zero;
+    static const BigInteger* p =
+        new BigInteger(BigInteger(0), std::pmr::new_delete_resource());
+    return *p;
   }
   static const BigInteger MinusOne() {
-    if (!_MinusOne) _MinusOne = std::unique_ptr<BigInteger>(new BigInteger(-1));
-    return *_MinusOne;
+    static const BigInteger* p =
+        new BigInteger(BigInteger(-1), std::pmr::new_delete_resource());
+    return *p;
   }
   // error biginteger (empty internal bytearray)
   static const BigInteger Error() {
-    if (!_Error) {
-      _Error = std::unique_ptr<BigInteger>(new BigInteger());
-      _Error->_data.clear();  // error biginteger (empty internal bytearray)
-    }
-    return *_Error;
+    static const BigInteger* p = []() {
+      BigInteger* e =
+          new BigInteger(BigInteger(), std::pmr::new_delete_resource());
+      e->_data.clear();  // error biginteger (empty internal bytearray)
+      return e;
+    }();
+    return *p;
   }
 
  public:
   // zero
-  BigInteger() noexcept : _data(cs_vbyte(1, 0x00)) {}
+  BigInteger() noexcept : _data(1, 0x00, GetThreadMemoryResource()) {}
 
-  // copy constructor
-  BigInteger(const BigInteger& copy) noexcept : _data(copy._data) {}
+  // copy constructor (storage goes to thread memory resource, as std::pmr)
+  BigInteger(const BigInteger& copy) noexcept
+      : _data(copy._data, GetThreadMemoryResource()) {}
 
-  // move constructor
+  // copy constructor into specific memory resource
+  BigInteger(const BigInteger& copy, std::pmr::memory_resource* res) noexcept
+      : _data(copy._data, res) {}
+
+  // move constructor (keeps memory resource of corpse)
   BigInteger(BigInteger&& corpse) noexcept : _data(std::move(corpse._data)) {}
 
   // destructor
@@ -110,16 +176,17 @@ class BigInteger final {
   // classic 'long long'
   BigInteger(cs_int64 value) : BigInteger(std::to_string(value), 10) {}
 
-  // from single-precision
-  BigInteger(float f);
-  // BigInteger(float f) :
-  // BigInteger(std::to_string((int)f), 10)
-  //{
-  // }
+  // from floating point: exact value truncated toward zero (as C#), or
+  // Error() for NaN and infinity. mantissa bits are placed directly
+  BigInteger(float f) { fromFloating(f); }
+
+  BigInteger(double d) { fromFloating(d); }
+
+  BigInteger(long double d) { fromFloating(d); }
 
   // byte data in little-endian format (by default).
   BigInteger(cs_vbyte data, bool isUnsigned = false, bool isBigEndian = false)
-      : _data(data) {
+      : _data(data.begin(), data.end(), GetThreadMemoryResource()) {
     if (_data.size() == 0) _data.push_back(0x00);  // default is zero, not Error
 
     if (!isBigEndian) reverse(_data.begin(), _data.end());  // to big-endian
@@ -169,7 +236,7 @@ class BigInteger final {
   // this one is little-endian by default
   cs_vbyte ToByteArray(bool isUnsigned = false,
                        bool isBigEndian = false) const {
-    cs_vbyte rdata = this->_data;  // big-endian
+    cs_vbyte rdata(_data.begin(), _data.end());  // big-endian
     if (isUnsigned) {
       while ((rdata.size() > 0) && (rdata[0] == 0))
         rdata.erase(rdata.begin() + 0);
@@ -180,28 +247,165 @@ class BigInteger final {
   }
 
   // this one is big-endian (prefixed 0x, to enforce hex format)
+  // base 2 is also two's complement (big-endian). other bases (3..36, 58 and
+  // 64) are signed magnitude, see ToChars
   std::string ToString(int base = 16) const {
     if (base == 16) {
-      std::stringstream ss;
-      ss << "0x" << Helper::revertHexString(this->toHexStr());  // to big-endian
-      return ss.str();
+      // nibbles of two's complement bytes
+      std::string s(2 + 2 * _data.size(), '0');
+      s[1] = 'x';
+      for (size_t i = 0; i < _data.size(); i++) {
+        s[2 + 2 * i] = Helper::digitChar(_data[i] >> 4);
+        s[3 + 2 * i] = Helper::digitChar(_data[i] & 0x0f);
+      }
+      return s;
     }
 
     if (base == 2) {
-      std::stringstream ss;
-      for (unsigned i = 0; i < _data.size(); i++)
-        ss << Helper::parseBin(_data[i]);  // byte to binary (TODO(igormcoelho):
-                                           // verify if size is 8)
-      return ss.str();
+      // bits of two's complement bytes (first byte without leading zeroes)
+      if (_data.empty()) return "";
+      int top = 8;
+      while ((top > 1) && !(_data[0] & (1 << (top - 1)))) top--;
+      std::string s(top + 8 * (_data.size() - 1), '0');
+      for (size_t k = 0; k < s.size(); k++) {
+        size_t bit = s.size() - 1 - k;  // from least significant
+        if ((_data[_data.size() - 1 - bit / 8] >> (bit % 8)) & 1) s[k] = '1';
+      }
+      return s;
     }
 
-    // base 10
-    return toStringBase10();
+    // bases that are not powers of two are superlinear: strings of large
+    // values may be cached (see BigIntegerStringCache)
+    std::string s;
+    bool large = ((base & (base - 1)) != 0) &&
+                 (_data.size() >= BigIntegerStringCache::MIN_BYTES);
+    if (large && BigIntegerStringCache::Find(_data.data(), _data.size(), base,
+                                             s))
+      return s;
+    if (base == 10) {
+      s = toStringBase10();
+    } else {
+      s.resize(maxChars(base));
+      std::to_chars_result r = ToChars(s.data(), s.data() + s.size(), base);
+      s.resize((r.ec == std::errc()) ? (r.ptr - s.data()) : 0);
+    }
+    if (large && !s.empty())
+      BigIntegerStringCache::Insert(_data.data(), _data.size(), base, s);
+    return s;
+  }
+
+  // writes digits into [first, last), as std::to_chars: '-' for negative
+  // values, then magnitude without prefix. bases 2..36 use lowercase digits,
+  // base 58 the bitcoin alphabet, and base 64 the base64url alphabet ('-' is
+  // a digit there, so only non-negative values are accepted).
+  // returns end of written chars, or {last, errc::value_too_large}
+  // ({first, errc::operation_canceled} when current BigIntegerContext is
+  // cancelled). allocates no result string: up to Limbs::DEC_SPLIT chunks
+  // (about 900 decimal digits) it works in thread-local scratch buffers,
+  // larger values also allocate working memory (powers, reciprocals and
+  // karatsuba temporaries)
+  std::to_chars_result ToChars(char* first, char* last, int base = 10) const;
+
+  // parses [first, last), as std::from_chars: optional '-' (except base 64),
+  // then digits (see ToChars). returns first char not consumed
+  // (errc::operation_canceled when current BigIntegerContext is cancelled);
+  // 'value' is only changed on success
+  static std::from_chars_result FromChars(const char* first, const char* last,
+                                          BigInteger& value, int base = 10);
+
+  static std::from_chars_result FromChars(std::string_view s,
+                                          BigInteger& value, int base = 10) {
+    return FromChars(s.data(), s.data() + s.size(), value, base);
   }
 
+  // writes ToString(10) to 'os' in blocks of 'chunk' digits, produced by
+  // divide and conquer (by powers 10^(chunk*2^j)), so the full string is
+  // never materialized
+  void WriteDecimal(std::ostream& os, size_t chunk = 8192) const;
+
+  // writes ToString(16) to 'os' in bounded blocks
+  void WriteHex(std::ostream& os) const;
+
+  // decimal, or ToString(16) format when 'os' is on std::hex
+  friend std::ostream& operator<<(std::ostream& os, const BigInteger& big) {
+    if ((os.flags() & std::ios::basefield) == std::ios::hex)
+      big.WriteHex(os);
+    else
+      big.WriteDecimal(os);
+    return os;
+  }
+
+  // whole 's' as FromChars, otherwise BigInteger::Error()
+  static BigInteger Parse(std::string_view s, int base = 10) {
+    BigInteger big;
+    std::from_chars_result r = FromChars(s, big, base);
+    if ((r.ec != std::errc()) || (r.ptr != s.data() + s.size()))
+      return BigInteger::Error();
+    return big;
+  }
+
+  // 10^n (Error() when n < 0), from the process-wide cache of powers
+  // 10^(DEC_DIGITS*2^k) (no engine arithmetic)
+  static BigInteger PowerOf10(cs_int32 n);
+
+  // fixed point: value / 10^decimals, as "-12345.678" (trailing fractional
+  // zeroes are removed, and the point when value is exact). digits are
+  // written once, point included. empty for Error() or decimals < 0
+  std::string ToDecimalString(int decimals) const;
+
+  // inverse of ToDecimalString: optional '-', digits, then optional '.' and
+  // digits (at least one digit in total). returns value * 10^decimals (the
+  // digits are parsed once, then scaled by PowerOf10), or Error() on invalid
+  // input or on nonzero fractional digits beyond 'decimals'
+  static BigInteger ParseDecimal(std::string_view s, int decimals);
+
  private:
   std::string toStringBase10() const;
 
+  template <class Float>
+  void fromFloating(Float v);
+
+  // upper bound for ToChars size (sign included)
+  size_t maxChars(int base) const {
+    int bits = 1;  // bits per digit (at least)
+    while ((2 << bits) <= base) bits++;
+    return 2 + (8 * _data.size() + bits - 1) / bits;
+  }
+
+  // WriteDecimal block: 'x' < pw[j]^2 (except leading blocks), zero padded
+  // when not leading. 'blocks' counts written blocks (of about 'total').
+  // false once current BigIntegerContext is cancelled
+  static bool writeDecimal(std::ostream& os, BigInteger x, int j, bool pad,
+                           const std::vector<BigInteger>& pw, size_t chunk,
+                           std::vector<char>& buf, size_t& blocks,
+                           size_t total);
+
+  // Pow of engines when a BigIntegerContext is installed: left-to-right
+  // squaring over engine multiplication, polled on every exponent bit
+  static BigInteger powPolled(const BigInteger& value, cs_int32 exponent);
+
+  // engine *, / and % go through limb kernels (cancellable, Error() once
+  // cancelled) when a BigIntegerContext is installed and both operands have
+  // Limbs::POLL_LIMBS limbs or more
+  static bool polled(const BigInteger& a, const BigInteger& b) {
+    return (BigIntegerContext::Current() != nullptr) &&
+           (std::min(a._data.size(), b._data.size()) >=
+            Limbs::POLL_LIMBS * sizeof(cs_limb));
+  }
+
+  static BigInteger mulPolled(const BigInteger& a, const BigInteger& b);
+
+  // quotient (truncated), or remainder (sign of dividend) when 'remainder'
+  static BigInteger divPolled(const BigInteger& a, const BigInteger& b,
+                              bool remainder);
+
+  // ToChars for bases that are not powers of two (magnitude is big-endian,
+  // without leading zeroes). a nonzero 'point' writes a '.' before the last
+  // 'point' digits, zero padded as "0.00ddd" when shorter
+  static std::to_chars_result toCharsChunked(const cs_byte* mag, size_t n,
+                                             int base, char* first,
+                                             char* last, size_t point = 0);
+
  public:
   // native int32 format
   cs_int32 toInt() const;
@@ -209,6 +413,22 @@ class BigInteger final {
   // native int64 format
   cs_int64 toLong() const;
 
+  // checked native formats, read straight from bytes (no engine call).
+  // return false (value unchanged) on overflow or Error()
+  bool TryToInt64(cs_int64& value) const;
+
+  bool TryToUInt64(cs_uint64& value) const;
+
+  // nearest double (ties to even), +-infinity beyond double range, NaN for
+  // Error()
+  double ToDouble() const;
+
+#ifdef __SIZEOF_INT128__
+  // low 128 bits (two's complement). 'overflow' tells if value does not fit
+  // (or is Error(), returned as zero)
+  cs_int128 ToInt128(bool& overflow) const;
+#endif
+
   cs_int32 Sign() const {
     if ((*this) == BigInteger::Zero())
       return 0;
@@ -224,6 +444,13 @@ class BigInteger final {
 
   static BigInteger Max(const BigInteger& big1, const BigInteger& big2);
 
+  // bits of shortest two's complement form, without sign bit (as C#
+  // GetBitLength): 0 for Zero(), MinusOne() and Error()
+  cs_int64 GetBitLength() const;
+
+  // trailing zero bits (as C# TrailingZeroCount): 0 for Zero() and Error()
+  cs_int64 TrailingZeroCount() const;
+
   // operators
 
   // ~ is the unary one's complement operator -- it flips the bits of its
@@ -305,12 +532,63 @@ class BigInteger final {
   // Utils
 
   // pow allows int32 positive exponent (negative will generate
-  // BigInteger::Error())
+  // BigInteger::Error()). when a BigIntegerContext is installed, squares and
+  // multiplies bit by bit (polling it) instead of one engine call
   static BigInteger Pow(BigInteger value, cs_int32 exponent);
   static BigInteger Multiply(BigInteger value1, BigInteger value2) {
     return value1 * value2;
   }
 
+  // product of all values, with a balanced tree (operands of similar size on
+  // every level). 'nthreads' > 1 multiplies independent subtrees in parallel
+  // (std::async workers do not inherit the MemoryResourceScope of the caller:
+  // their partial products use the default resource). empty range is
+  // BigInteger::One()
+  template <class It>
+  static BigInteger ProductTree(It first, It last, unsigned nthreads = 1) {
+    return productTree(first, std::distance(first, last), nthreads);
+  }
+
+  static BigInteger ProductTree(const std::vector<BigInteger>& values,
+                                unsigned nthreads = 1) {
+    return ProductTree(values.begin(), values.end(), nthreads);
+  }
+
+  // n! (prime-swing algorithm). negative n will generate BigInteger::Error()
+  static BigInteger Factorial(cs_int32 n, unsigned nthreads = 1);
+
+  // n choose k (zero when k < 0 or k > n). negative n will generate
+  // BigInteger::Error()
+  static BigInteger Binomial(cs_int32 n, cs_int32 k, unsigned nthreads = 1);
+
+ private:
+  template <class It>
+  static BigInteger productTree(It first, size_t n, unsigned nthreads) {
+    if (n == 0) return BigInteger::One();
+    if (n == 1) return *first;
+    size_t half = n / 2;
+    It mid = std::next(first, half);
+    if (nthreads > 1) {
+      auto left = std::async(std::launch::async, [first, half, nthreads]() {
+        return productTree(first, half, nthreads / 2);
+      });
+      BigInteger right = productTree(mid, n - half, nthreads - nthreads / 2);
+      return left.get() * right;
+    }
+    return productTree(first, half, 1) * productTree(mid, n - half, 1);
+  }
+
+  // product of small factors (packed into int64 words before the tree)
+  static BigInteger productOfFactors(const std::vector<cs_int64>& factors,
+                                     unsigned nthreads);
+
+  // n! / ((n/2)!)^2, from primes up to n
+  static BigInteger swing(cs_int32 n, const std::vector<cs_int32>& primes,
+                          unsigned nthreads);
+
+  static BigInteger factorial(cs_int32 n, const std::vector<cs_int32>& primes,
+                              unsigned nthreads);
+
  public:
   // object accessible helper method
   // hex string is returned on little-endian
@@ -348,6 +626,559 @@ class BigInteger final {
   static const BigInteger error();
 };
 
+// ================ sign and order ===================
+// engine independent (Error() if any operand is Error())
+
+inline BigInteger BigInteger::Abs(const BigInteger& big) {
+  if (big.IsError()) return BigInteger::Error();
+  return (big._data[0] & 0x80) ? -big : big;
+}
+
+inline BigInteger BigInteger::Min(const BigInteger& big1,
+                                  const BigInteger& big2) {
+  if (big1.IsError() || big2.IsError()) return BigInteger::Error();
+  return (big2 < big1) ? big2 : big1;
+}
+
+inline BigInteger BigInteger::Max(const BigInteger& big1,
+                                  const BigInteger& big2) {
+  if (big1.IsError() || big2.IsError()) return BigInteger::Error();
+  return (big1 < big2) ? big2 : big1;
+}
+
+// ================ bits ===================
+// engine independent (two's complement bytes)
+
+inline cs_int64 BigInteger::GetBitLength() const {
+  size_t n = _data.size();
+  if (n == 0) return 0;  // Error()
+  cs_byte ext = (_data[0] & 0x80) ? 0xff : 0x00;  // sign extension
+  size_t i = 0;
+  while ((i < n) && (_data[i] == ext)) i++;
+  if (i == n) return 0;  // 0 or -1
+  int bits = 0;
+  for (cs_byte b = _data[i] ^ ext; b != 0; b >>= 1) bits++;
+  return static_cast<cs_int64>(8 * (n - 1 - i) + bits);
+}
+
+inline cs_int64 BigInteger::TrailingZeroCount() const {
+  size_t n = _data.size();
+  size_t i = n;
+  while ((i > 0) && (_data[i - 1] == 0)) i--;
+  if (i == 0) return 0;  // 0 or Error()
+  int bits = 0;
+  for (cs_byte b = _data[i - 1]; (b & 1) == 0; b >>= 1) bits++;
+  return static_cast<cs_int64>(8 * (n - i) + bits);
+}
+
+// ================ combinatorics ===================
+// engine independent (only depends on multiplication)
+
+inline BigInteger BigInteger::productOfFactors(
+    const std::vector<cs_int64>& factors, unsigned nthreads) {
+  std::vector<BigInteger> words;
+  cs_int64 acc = 1;
+  for (cs_int64 f : factors) {
+    if (acc > std::numeric_limits<cs_int64>::max() / f) {
+      words.push_back(BigInteger(acc));
+      acc = f;
+    } else {
+      acc *= f;
+    }
+  }
+  words.push_back(BigInteger(acc));
+  return ProductTree(words, nthreads);
+}
+
+inline BigInteger BigInteger::swing(cs_int32 n,
+                                    const std::vector<cs_int32>& primes,
+                                    unsigned nthreads) {
+  // exponent of p is the number of odd terms in n/p, n/p^2, ...
+  std::vector<cs_int64> factors;
+  for (cs_int32 p : primes) {
+    if (p > n) break;
+    for (cs_int32 q = n / p; q > 0; q /= p)
+      if (q & 1) factors.push_back(p);
+  }
+  return productOfFactors(factors, nthreads);
+}
+
+inline BigInteger BigInteger::factorial(cs_int32 n,
+                                        const std::vector<cs_int32>& primes,
+                                        unsigned nthreads) {
+  if (n < 21) {  // 20! fits int64
+    cs_int64 f = 1;
+    for (cs_int32 i = 2; i <= n; i++) f *= i;
+    return BigInteger(f);
+  }
+  // n! = ((n/2)!)^2 * swing(n)
+  if (nthreads > 1) {
+    auto sw = std::async(std::launch::async, [n, &primes, nthreads]() {
+      return swing(n, primes, nthreads / 2);
+    });
+    BigInteger half = factorial(n / 2, primes, nthreads - nthreads / 2);
+    return half * half * sw.get();
+  }
+  BigInteger half = factorial(n / 2, primes, 1);
+  return half * half * swing(n, primes, 1);
+}
+
+inline BigInteger BigInteger::Factorial(cs_int32 n, unsigned nthreads) {
+  if (n < 0) return BigInteger::Error();
+  if (n < 21) return factorial(n, {}, 1);
+  return factorial(n, Helper::primesUpTo(n), nthreads);
+}
+
+inline BigInteger BigInteger::Binomial(cs_int32 n, cs_int32 k,
+                                       unsigned nthreads) {
+  if (n < 0) return BigInteger::Error();
+  if ((k < 0) || (k > n)) return BigInteger::Zero();
+  k = std::min(k, n - k);
+  // exponent of p is the number of borrows of n - k in base p (Kummer)
+  std::vector<cs_int64> factors;
+  for (cs_int32 p : Helper::primesUpTo(n)) {
+    cs_int32 qn = n, qk = k, qr = n - k;
+    while (qn > 0) {
+      qn /= p;
+      qk /= p;
+      qr /= p;
+      for (cs_int32 e = qn - qk - qr; e > 0; e--) factors.push_back(p);
+    }
+  }
+  return productOfFactors(factors, nthreads);
+}
+
+// ================ chars ===================
+// engine independent (limb kernel)
+
+inline std::to_chars_result BigInteger::ToChars(char* first, char* last,
+                                                int base) const {
+  if (_data.empty() || !Helper::isRadix(base))
+    return {first, std::errc::invalid_argument};
+  cs_vbyte& bytes = Limbs::scratch().bytes;
+  bool negative = Helper::toMagnitude(_data.data(), _data.size(), bytes);
+  if (negative && (base == 64)) return {first, std::errc::invalid_argument};
+  size_t skip = 0;
+  while ((skip < bytes.size()) && (bytes[skip] == 0)) skip++;
+  const cs_byte* mag = bytes.data() + skip;
+  size_t n = bytes.size() - skip;
+  char* out = first;
+  if (negative) {
+    if (out == last) return {last, std::errc::value_too_large};
+    *out++ = '-';
+  }
+  if (n == 0) {
+    if (out == last) return {last, std::errc::value_too_large};
+    *out++ = Helper::digitChar(0, base);
+    return {out, std::errc()};
+  }
+  int bits = Helper::radixBits(base);
+  if (bits == 0) return toCharsChunked(mag, n, base, out, last);
+  // power of two base: each digit is a slice of 'bits' bits
+  int top = 8;
+  while (!(mag[0] & (1 << (top - 1)))) top--;
+  size_t ndigits = (8 * (n - 1) + top + bits - 1) / bits;
+  if (static_cast<size_t>(last - out) < ndigits)
+    return {last, std::errc::value_too_large};
+  for (size_t i = 0; i < ndigits; i++) {
+    size_t bit = i * bits;
+    size_t k = n - 1 - bit / 8;  // byte holding lowest bit of digit
+    unsigned v = mag[k] | ((k > 0) ? (mag[k - 1] << 8) : 0);
+    out[ndigits - 1 - i] =
+        Helper::digitChar((v >> (bit % 8)) & (base - 1), base);
+  }
+  return {out + ndigits, std::errc()};
+}
+
+inline std::to_chars_result BigInteger::toCharsChunked(const cs_byte* mag,
+                                                       size_t n, int base,
+                                                       char* first,
+                                                       char* last,
+                                                       size_t point) {
+  // chunks of 'width' digits (least significant first), by halves over the
+  // shared powers for long inputs
+  int width;
+  Limbs::radixChunk(base, width);
+  Limbs::Scratch& s = Limbs::scratch();
+  Limbs::fromBytes(mag, n, s.limbs);
+  if (!Limbs::toChunks(base, s.limbs, s.chunks))
+    return {first, std::errc::operation_canceled};
+  while ((s.chunks.size() > 1) && (s.chunks.back() == 0)) s.chunks.pop_back();
+  size_t top = 1;
+  for (cs_limb c = s.chunks.back(); c >= static_cast<cs_limb>(base); c /= base)
+    top++;
+  size_t ndigits = top + width * (s.chunks.size() - 1);
+  size_t nchars = ndigits;
+  if (point > 0) nchars = (ndigits > point) ? (ndigits + 1) : (point + 2);
+  if (static_cast<size_t>(last - first) < nchars)
+    return {last, std::errc::value_too_large};
+  char* out = first + nchars;
+  size_t written = 0;
+  for (size_t i = 0; i < s.chunks.size(); i++) {
+    cs_limb c = s.chunks[i];
+    size_t len = (i + 1 < s.chunks.size()) ? width : top;
+    for (size_t k = 0; k < len; k++, c /= base, written++) {
+      if ((point > 0) && (written == point)) *--out = '.';
+      *--out = Helper::digitChar(static_cast<int>(c % base), base);
+    }
+  }
+  if ((point > 0) && (written <= point)) {
+    while (out > first + 2) *--out = '0';
+    first[1] = '.';
+    first[0] = '0';
+  }
+  return {first + nchars, std::errc()};
+}
+
+inline std::from_chars_result BigInteger::FromChars(const char* first,
+                                                    const char* last,
+                                                    BigInteger& value,
+                                                    int base) {
+  if (!Helper::isRadix(base)) return {first, std::errc::invalid_argument};
+  const char* p = first;
+  bool negative = (base != 64) && (p != last) && (*p == '-');
+  if (negative) p++;
+  const char* digits = p;
+  if (base == 10)
+    p = Limbs::decimalRun(p, last);
+  else
+    while ((p != last) && (Helper::digitValue(*p, base) < base)) p++;
+  if (p == digits) return {first, std::errc::invalid_argument};
+  if ((base == 10) && (p - digits <= Limbs::DEC_DIGITS)) {
+    // single limb (no scratch)
+    cs_byte mag[sizeof(cs_limb)];
+    Limbs::toBytes(Limbs::decimalChunk(digits, p - digits), mag);
+    Helper::fromMagnitude(mag, sizeof(mag), negative, value._data);
+    return {p, std::errc()};
+  }
+  Limbs::Scratch& s = Limbs::scratch();
+  int bits = Helper::radixBits(base);
+  if (base == 10) {
+    Limbs::fromDecimal(digits, p, s.limbs);
+    Limbs::toBytes(s.limbs, s.bytes);
+  } else if (bits == 0) {
+    Limbs::fromRadix(digits, p, base, s.limbs);
+    Limbs::toBytes(s.limbs, s.bytes);
+  }
+  if ((bits == 0) && BigIntegerContext::Cancelled())
+    return {first, std::errc::operation_canceled};
+  if (bits != 0) {
+    // power of two base: each digit is a slice of 'bits' bits
+    size_t ndigits = p - digits;
+    s.bytes.assign((ndigits * bits + 7) / 8, 0);
+    for (size_t i = 0; i < ndigits; i++) {
+      size_t bit = i * bits;
+      size_t k = s.bytes.size() - 1 - bit / 8;
+      char c = p[-1 - static_cast<std::ptrdiff_t>(i)];
+      unsigned v = Helper::digitValue(c, base) << (bit % 8);
+      s.bytes[k] |= static_cast<cs_byte>(v);
+      if (v >> 8) s.bytes[k - 1] |= static_cast<cs_byte>(v >> 8);
+    }
+  }
+  Helper::fromMagnitude(s.bytes.data(), s.bytes.size(), negative, value._data);
+  return {p, std::errc()};
+}
+
+// ================ powers ===================
+// engine independent (limb kernel, shared power cache, context polling)
+
+inline BigInteger BigInteger::PowerOf10(cs_int32 n) {
+  if (n < 0) return BigInteger::Error();
+  // 10^n = DEC_BASE^q * 10^r (q by its bits)
+  size_t q = n / Limbs::DEC_DIGITS;
+  int r = n % Limbs::DEC_DIGITS;
+  size_t levels = 0;
+  while ((q >> levels) != 0) levels++;
+  std::vector<const cs_vlimb*> pw;
+  std::vector<cs_vlimb> own;
+  Limbs::powers(10, levels, pw, own);
+  cs_vlimb acc(1, Limbs::pow10(r)), t;
+  for (size_t j = 0; j < levels; j++) {
+    if (((q >> j) & 1) == 0) continue;
+    Limbs::mul(acc, *pw[j], t);
+    acc.swap(t);
+  }
+  if (BigIntegerContext::Cancelled()) return BigInteger::Error();
+  cs_vbyte mag;
+  Limbs::toBytes(acc, mag);
+  BigInteger big;
+  Helper::fromMagnitude(mag.data(), mag.size(), false, big._data);
+  return big;
+}
+
+inline BigInteger BigInteger::powPolled(const BigInteger& value,
+                                        cs_int32 exponent) {
+  if ((exponent < 0) || value.IsError()) return BigInteger::Error();
+  int nbits = 0;
+  while ((nbits < 31) && ((exponent >> nbits) != 0)) nbits++;
+  BigInteger r = BigInteger::One();
+  for (int i = 0; i < nbits; i++) {
+    if (!BigIntegerContext::Poll("pow", i, nbits)) return BigInteger::Error();
+    if (i > 0) r = r * r;
+    if ((exponent >> (nbits - 1 - i)) & 1) r = r * value;
+  }
+  if (!BigIntegerContext::Poll("pow", nbits, nbits))
+    return BigInteger::Error();
+  return r;
+}
+
+inline BigInteger BigInteger::mulPolled(const BigInteger& a,
+                                        const BigInteger& b) {
+  cs_vbyte mag;
+  cs_vlimb x, y, r;
+  bool negative = Helper::toMagnitude(a._data.data(), a._data.size(), mag);
+  Limbs::fromBytes(mag.data(), mag.size(), x);
+  negative ^= Helper::toMagnitude(b._data.data(), b._data.size(), mag);
+  Limbs::fromBytes(mag.data(), mag.size(), y);
+  Limbs::mul(x, y, r);  // polls every karatsuba level
+  if (BigIntegerContext::Cancelled()) return BigInteger::Error();
+  Limbs::toBytes(r, mag);
+  BigInteger big;
+  Helper::fromMagnitude(mag.data(), mag.size(), negative && !r.empty(),
+                        big._data);
+  return big;
+}
+
+inline BigInteger BigInteger::divPolled(const BigInteger& a,
+                                        const BigInteger& b, bool remainder) {
+  cs_vbyte mag;
+  cs_vlimb x, y, q, r;
+  bool negative = Helper::toMagnitude(a._data.data(), a._data.size(), mag);
+  Limbs::fromBytes(mag.data(), mag.size(), x);
+  bool negativeQ =
+      negative ^ Helper::toMagnitude(b._data.data(), b._data.size(), mag);
+  Limbs::fromBytes(mag.data(), mag.size(), y);
+  if (!Limbs::divRem(x, y, q, r)) return BigInteger::Error();
+  cs_vlimb& out = remainder ? r : q;
+  if (!remainder) negative = negativeQ;
+  Limbs::toBytes(out, mag);
+  BigInteger big;
+  Helper::fromMagnitude(mag.data(), mag.size(), negative && !out.empty(),
+                        big._data);
+  return big;
+}
+
+// ================ native ===================
+// engine independent (two's complement bytes)
+
+inline bool BigInteger::TryToInt64(cs_int64& value) const {
+  size_t n = _data.size();
+  if ((n == 0) || (n > 8)) return false;  // compressed: n bytes are needed
+  cs_uint64 v = (_data[0] & 0x80) ? ~cs_uint64{0} : 0;  // sign extension
+  for (size_t i = 0; i < n; i++) v = (v << 8) | _data[i];
+  value = static_cast<cs_int64>(v);
+  return true;
+}
+
+inline bool BigInteger::TryToUInt64(cs_uint64& value) const {
+  size_t n = _data.size();
+  if ((n == 0) || (_data[0] & 0x80) || (n > 9) || ((n == 9) && _data[0]))
+    return false;
+  cs_uint64 v = 0;
+  for (size_t i = 0; i < n; i++) v = (v << 8) | _data[i];
+  value = v;
+  return true;
+}
+
+inline double BigInteger::ToDouble() const {
+  cs_int64 small;
+  if (TryToInt64(small)) return static_cast<double>(small);  // rounded
+  if (_data.empty()) return std::numeric_limits<double>::quiet_NaN();
+  cs_vbyte& mag = Limbs::scratch().bytes;
+  bool negative = Helper::toMagnitude(_data.data(), _data.size(), mag);
+  size_t n = mag.size();
+  size_t first = 0;
+  while (mag[first] == 0) first++;
+  int lead = 8;
+  while (!(mag[first] & (1 << (lead - 1)))) lead--;
+  size_t bits = 8 * (n - first - 1) + lead;
+  // top 64 bits, lower ones folded in a sticky bit (64 > 53 + 2, so the
+  // conversion of 'top' rounds as the whole magnitude)
+  size_t shift = (bits > 64) ? (bits - 64) : 0;
+  cs_uint64 top = 0;
+  for (size_t i = bits; i-- > shift;)
+    top = (top << 1) | ((mag[n - 1 - i / 8] >> (i % 8)) & 1);
+  bool sticky = false;
+  for (size_t i = 0; !sticky && (i < shift / 8); i++)
+    sticky = (mag[n - 1 - i] != 0);
+  if (shift % 8) sticky |= (mag[n - 1 - shift / 8] & ((1 << (shift % 8)) - 1));
+  int e = static_cast<int>(std::min<size_t>(shift, 4096));  // inf beyond
+  double d = std::ldexp(static_cast<double>(top | sticky), e);
+  return negative ? -d : d;
+}
+
+#ifdef __SIZEOF_INT128__
+inline cs_int128 BigInteger::ToInt128(bool& overflow) const {
+  size_t n = _data.size();
+  overflow = (n == 0) || (n > 16);
+  if (n == 0) return 0;
+  // low 16 bytes, sign extended
+  cs_dlimb v = (_data[0] & 0x80) ? ~static_cast<cs_dlimb>(0) : 0;
+  for (size_t i = (n > 16) ? (n - 16) : 0; i < n; i++) v = (v << 8) | _data[i];
+  return static_cast<cs_int128>(v);
+}
+#endif
+
+// ================ floating point ===================
+// engine independent (bytes taken from mantissa, 8 bits at a time)
+
+template <class Float>
+inline void BigInteger::fromFloating(Float v) {
+  if (!std::isfinite(v)) {
+    _data.clear();  // Error()
+    return;
+  }
+  v = std::trunc(v);
+  bool negative = std::signbit(v);
+  int e;
+  Float m = std::frexp(std::fabs(v), &e);  // |v| = m * 2^e, m in [0.5, 1)
+  if (m == 0) {
+    _data.assign(1, 0x00);
+    return;
+  }
+  // 'e' bits (integer): top byte gets e % 8 of them. all steps are exact
+  cs_vbyte& mag = Limbs::scratch().bytes;
+  mag.assign((e + 7) / 8, 0);
+  int bits = (e % 8 == 0) ? 8 : (e % 8);
+  for (size_t i = 0; (m != 0) && (i < mag.size()); i++, bits = 8) {
+    m = std::ldexp(m, bits);
+    Float d = std::floor(m);
+    mag[i] = static_cast<cs_byte>(d);
+    m -= d;
+  }
+  Helper::fromMagnitude(mag.data(), mag.size(), negative, _data);
+}
+
+// ================ fixed point ===================
+// engine independent (decimal point handled on digits)
+
+inline std::string BigInteger::ToDecimalString(int decimals) const {
+  if (_data.empty() || (decimals < 0)) return "";
+  cs_vbyte& bytes = Limbs::scratch().bytes;
+  bool negative = Helper::toMagnitude(_data.data(), _data.size(), bytes);
+  size_t skip = 0;
+  while ((skip < bytes.size()) && (bytes[skip] == 0)) skip++;
+  if (skip == bytes.size()) return "0";
+  size_t d = static_cast<size_t>(decimals);
+  std::string s(std::max(maxChars(10), d + 3), '\0');
+  char* out = s.data();
+  if (negative) *out++ = '-';
+  std::to_chars_result r = toCharsChunked(bytes.data() + skip,
+                                          bytes.size() - skip, 10, out,
+                                          s.data() + s.size(), d);
+  if (r.ec != std::errc()) return "";
+  size_t len = r.ptr - s.data();
+  if (d > 0) {
+    while (s[len - 1] == '0') len--;
+    if (s[len - 1] == '.') len--;
+  }
+  s.resize(len);
+  return s;
+}
+
+inline BigInteger BigInteger::ParseDecimal(std::string_view s, int decimals) {
+  if (decimals < 0) return BigInteger::Error();
+  size_t point = s.find('.');
+  std::string_view ip = s.substr(0, point);
+  std::string_view fp;
+  if (point != std::string_view::npos) fp = s.substr(point + 1);
+  bool negative = !ip.empty() && (ip[0] == '-');
+  if (negative) ip.remove_prefix(1);
+  const char* ipEnd = ip.data() + ip.size();
+  const char* fpEnd = fp.data() + fp.size();
+  if ((ip.size() + fp.size() == 0) ||
+      (Limbs::decimalRun(ip.data(), ipEnd) != ipEnd) ||
+      (Limbs::decimalRun(fp.data(), fpEnd) != fpEnd))
+    return BigInteger::Error();
+  // fractional digits beyond precision must be zeroes
+  size_t d = static_cast<size_t>(decimals);
+  if (fp.size() > d) {
+    for (size_t i = d; i < fp.size(); i++)
+      if (fp[i] != '0') return BigInteger::Error();
+    fp = fp.substr(0, d);
+  }
+  std::string digits;
+  digits.reserve(2 + ip.size() + fp.size());
+  if (negative) digits += '-';
+  digits.append(ip);
+  digits.append(fp);
+  if (ip.empty() && fp.empty()) digits += '0';  // like ".0" on zero decimals
+  BigInteger value = Parse(digits);
+  if (value.IsError() || (fp.size() == d)) return value;
+  return value * PowerOf10(static_cast<cs_int32>(d - fp.size()));
+}
+
+// ================ streams ===================
+// engine independent (division by large powers of ten comes from engine)
+
+inline void BigInteger::WriteDecimal(std::ostream& os, size_t chunk) const {
+  if (_data.empty()) return;  // Error()
+  if (chunk == 0) chunk = 1;
+  BigInteger x = (*this);
+  if (x.Sign() < 0) {
+    os.put('-');
+    x = -x;
+  }
+  // pw[j] = 10^(chunk*2^j), while pw[j]^2 may still be below x
+  // (none when x fits a single block)
+  std::vector<BigInteger> pw;
+  if (x.maxChars(10) > chunk + 2) {
+    pw.push_back(BigInteger::PowerOf10(static_cast<cs_int32>(chunk)));
+    while (!pw.back().IsError() && (2 * pw.back().Length() <= x.Length() + 1))
+      pw.push_back(pw.back() * pw.back());
+    if (pw.back().IsError()) {  // cancelled
+      os.setstate(std::ios::failbit);
+      return;
+    }
+  }
+  std::vector<char> buf;  // one block at a time
+  size_t blocks = 0, total = x.maxChars(10) / chunk + 1;
+  if (!writeDecimal(os, std::move(x), static_cast<int>(pw.size()) - 1, false,
+                    pw, chunk, buf, blocks, total))
+    os.setstate(std::ios::failbit);
+}
+
+inline bool BigInteger::writeDecimal(std::ostream& os, BigInteger x, int j,
+                                     bool pad, const std::vector<BigInteger>& pw,
+                                     size_t chunk, std::vector<char>& buf,
+                                     size_t& blocks, size_t total) {
+  if (j < 0) {
+    // block: zero padded to 'chunk' digits, except leading one
+    buf.resize(x.maxChars(10));
+    std::to_chars_result r = x.ToChars(buf.data(), buf.data() + buf.size());
+    if (r.ec != std::errc()) return false;
+    size_t n = r.ptr - buf.data();
+    for (size_t k = n; pad && (k < chunk); k++) os.put('0');
+    os.write(buf.data(), n);
+    return BigIntegerContext::Poll("write_decimal", ++blocks, total);
+  }
+  if (!pad && (x < pw[j]))
+    return writeDecimal(os, std::move(x), j - 1, false, pw, chunk, buf, blocks,
+                        total);
+  BigInteger r;
+  BigInteger q = BigInteger::DivRem(x, pw[j], r);
+  x = BigInteger::Zero();  // release before recursion
+  return writeDecimal(os, std::move(q), j - 1, pad, pw, chunk, buf, blocks,
+                      total) &&
+         writeDecimal(os, std::move(r), j - 1, true, pw, chunk, buf, blocks,
+                      total);
+}
+
+inline void BigInteger::WriteHex(std::ostream& os) const {
+  char buf[4096];
+  os.write("0x", 2);
+  size_t n = 0;
+  for (size_t i = 0; i < _data.size(); i++) {
+    buf[n++] = Helper::digitChar(_data[i] >> 4);
+    buf[n++] = Helper::digitChar(_data[i] & 0x0f);
+    if (n == sizeof(buf)) {
+      os.write(buf, n);
+      n = 0;
+    }
+  }
+  os.write(buf, n);
+}
+
 }  // namespace csbiginteger
 
 //
@@ -0,0 +1,168 @@
+// SPDX-License-Identifier:  MIT
+// Copyright (C) 2020-2022 - csbiginteger-cpp project
+
+#ifndef CS_BIGINTEGER_ACCUMULATOR_HPP
+#define CS_BIGINTEGER_ACCUMULATOR_HPP
+
+// c++
+#include <algorithm>
+#include <vector>
+
+// internal classes
+#include <csbiginteger/BigInteger.h>
+
+namespace csbiginteger {
+
+// Accumulator for long sequences of additions and subtractions.
+//
+// Value is sum(limbs[i] * 2^(32*i)): each int64 limb holds a 32-bit digit plus
+// carries not propagated yet (redundant representation). Operations only touch
+// the limbs covered by the operand, and carries are propagated every HEADROOM
+// operations or when ToBigInteger() is called.
+//
+// Example:
+//   BigIntegerAccumulator acc;
+//   for (auto& x : values) acc += x;
+//   BigInteger total = acc.ToBigInteger();
+class BigIntegerAccumulator final {
+ private:
+  std::vector<cs_int64> limbs;
+  cs_vbyte bytes;       // little-endian bytes of current operand
+  cs_int64 pending{0};  // operations since last normalization
+  bool error{false};    // some operand was Error()
+
+ public:
+  // each operation moves a limb by less than 2^32 (either direction), so two
+  // merged accumulators stay below 2^(32+30)
+  static constexpr cs_int64 HEADROOM = cs_int64{1} << 29;
+
+  // 'capacity' is the expected size (in bytes) of the result
+  explicit BigIntegerAccumulator(size_t capacity = 32)
+      : limbs(std::max<size_t>(2, (capacity + 3) / 4 + 1), 0) {
+    bytes.reserve(capacity);
+  }
+
+  explicit BigIntegerAccumulator(const BigInteger& big)
+      : BigIntegerAccumulator(big.Length()) {
+    add(big);
+  }
+
+  void add(const BigInteger& big) { apply(big, 1); }
+
+  void sub(const BigInteger& big) { apply(big, -1); }
+
+  void add(cs_int64 v) {
+    // unsigned low digit and signed high digit
+    limbs[0] += static_cast<cs_int64>(static_cast<cs_uint64>(v) & 0xffffffff);
+    limbs[1] += v >> 32;
+    step();
+  }
+
+  void sub(cs_int64 v) {
+    limbs[0] -= static_cast<cs_int64>(static_cast<cs_uint64>(v) & 0xffffffff);
+    limbs[1] -= v >> 32;
+    step();
+  }
+
+  BigIntegerAccumulator& operator+=(const BigInteger& big) {
+    add(big);
+    return *this;
+  }
+
+  BigIntegerAccumulator& operator-=(const BigInteger& big) {
+    sub(big);
+    return *this;
+  }
+
+  BigIntegerAccumulator& operator+=(cs_int64 v) {
+    add(v);
+    return *this;
+  }
+
+  BigIntegerAccumulator& operator-=(cs_int64 v) {
+    sub(v);
+    return *this;
+  }
+
+  // add another accumulator (limb by limb, carries still pending)
+  void merge(const BigIntegerAccumulator& other) {
+    error = error || other.error;
+    if (limbs.size() < other.limbs.size()) limbs.resize(other.limbs.size(), 0);
+    for (size_t i = 0; i < other.limbs.size(); i++) limbs[i] += other.limbs[i];
+    pending += other.pending;
+    if (pending >= HEADROOM) normalize();
+  }
+
+  // back to zero (keeps capacity)
+  void clear() {
+    std::fill(limbs.begin(), limbs.end(), 0);
+    pending = 0;
+    error = false;
+  }
+
+  // propagate carries: all limbs become 32-bit digits, except the most
+  // significant one, that keeps the sign
+  void normalize() {
+    cs_int64 carry = 0;
+    for (size_t i = 0; i < limbs.size(); i++) {
+      cs_int64 v = limbs[i] + carry;
+      limbs[i] = v & 0xffffffff;
+      carry = v >> 32;  // arithmetic shift (floor)
+    }
+    while ((carry != 0) && (carry != -1)) {
+      limbs.push_back(carry & 0xffffffff);
+      carry >>= 32;
+    }
+    if (carry == -1) limbs.back() -= cs_int64{1} << 32;  // negative value
+    pending = 0;
+  }
+
+  // normalized value (Error() if any operand was Error())
+  BigInteger ToBigInteger() {
+    if (error) return BigInteger::Error();
+    normalize();
+    // big-endian bytes: sign byte, then all limbs
+    cs_vbyte data(1 + 4 * limbs.size());
+    data[0] = (limbs.back() < 0) ? 0xff : 0x00;
+    for (size_t i = 0; i < limbs.size(); i++)
+      for (int b = 0; b < 4; b++)
+        data[data.size() - 1 - (4 * i + b)] =
+            static_cast<cs_byte>(limbs[i] >> (8 * b));
+    Helper::compress(data);
+    return BigInteger(data, false, true);
+  }
+
+ private:
+  void step() {
+    if (++pending == HEADROOM) normalize();
+  }
+
+  // limbs += sign * big
+  void apply(const BigInteger& big, int sign) {
+    int n = big.Length();
+    if (n == 0) {
+      error = true;  // Error() is empty
+      return;
+    }
+    bytes.resize(n);
+    big.CopyTo(bytes.data(), n);  // little-endian
+    cs_byte fill = (bytes[n - 1] & 0x80) ? 0xff : 0x00;
+    size_t ndigits = (n + 3) / 4;
+    if (limbs.size() < ndigits + 1) limbs.resize(ndigits + 1, 0);
+    for (size_t d = 0; d < ndigits; d++) {
+      cs_uint32 digit = 0;
+      for (int b = 3; b >= 0; b--) {
+        size_t k = 4 * d + b;
+        digit = (digit << 8) | (k < bytes.size() ? bytes[k] : fill);
+      }
+      cs_int64 v = (d + 1 < ndigits) ? cs_int64{digit}
+                                     : static_cast<cs_int32>(digit);  // sign
+      limbs[d] += sign * v;
+    }
+    step();
+  }
+};
+
+}  // namespace csbiginteger
+
+#endif  // CS_BIGINTEGER_ACCUMULATOR_HPP
@@ -0,0 +1,191 @@
+// SPDX-License-Identifier:  MIT
+// Copyright (C) 2020-2022 - csbiginteger-cpp project
+
+#ifndef CS_BIGINTEGER_ASYNC_HPP
+#define CS_BIGINTEGER_ASYNC_HPP
+
+// internal classes
+#include <csbiginteger/BigInteger.h>
+
+// coroutine awaitables (c++20 coroutines only)
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+// c++
+#include <algorithm>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace csbiginteger {
+
+namespace async {
+
+// cooperative cancellation (copies share it): a BigIntegerContext that
+// operations install on their executor thread, so engine calls stop at their
+// next poll and give Error() (or empty string) once cancelled
+class CancellationToken {
+ public:
+  CancellationToken() : context(std::make_shared<BigIntegerContext>()) {}
+
+  void Cancel() const { context->Cancel(); }
+
+  bool IsCancelled() const { return context->IsCancelled(); }
+
+  BigIntegerContext* Context() const { return context.get(); }
+
+ private:
+  std::shared_ptr<BigIntegerContext> context;
+};
+
+// fixed thread pool running operations (FIFO)
+class Executor {
+ public:
+  // 0 means hardware concurrency
+  explicit Executor(unsigned nthreads = 0) {
+    if (nthreads == 0) nthreads = std::thread::hardware_concurrency();
+    for (unsigned t = 0; t < std::max(1u, nthreads); t++)
+      threads.emplace_back([this]() { work(); });
+  }
+
+  // runs queued work, then joins
+  ~Executor() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    cv.notify_all();
+    for (std::thread& t : threads) t.join();
+  }
+
+  Executor(const Executor&) = delete;
+  Executor& operator=(const Executor&) = delete;
+
+  void Post(std::function<void()> f) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      queue.push_back(std::move(f));
+    }
+    cv.notify_one();
+  }
+
+  // library-managed executor
+  static Executor& Default() {
+    static Executor executor;
+    return executor;
+  }
+
+ private:
+  std::vector<std::thread> threads;
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<std::function<void()>> queue;
+  bool stopping{false};
+
+  void work() {
+    while (true) {
+      std::function<void()> f;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this]() { return stopping || !queue.empty(); });
+        if (queue.empty()) return;  // stopping
+        f = std::move(queue.front());
+        queue.pop_front();
+      }
+      f();
+    }
+  }
+};
+
+// awaitable: runs 'f' on executor, then resumes awaiting coroutine there
+template <class T>
+class Operation {
+ public:
+  Operation(std::function<T()> f, Executor& executor)
+      : f(std::move(f)), executor(executor) {}
+
+  bool await_ready() const noexcept { return false; }
+
+  void await_suspend(std::coroutine_handle<> h) {
+    executor.Post([this, h]() {
+      try {
+        result = f();
+      } catch (...) {
+        error = std::current_exception();
+      }
+      h.resume();
+    });
+  }
+
+  T await_resume() {
+    if (error) std::rethrow_exception(error);
+    return std::move(result);
+  }
+
+ private:
+  std::function<T()> f;
+  Executor& executor;
+  T result;
+  std::exception_ptr error;
+};
+
+// a * b (large operands run on the polled limb multiplication, so the token
+// stops it midway)
+inline Operation<BigInteger> multiply(
+    BigInteger a, BigInteger b, CancellationToken token = CancellationToken(),
+    Executor& executor = Executor::Default()) {
+  return Operation<BigInteger>(
+      [a = std::move(a), b = std::move(b), token]() {
+        if (token.IsCancelled()) return BigInteger::Error();
+        BigIntegerContext::Scope scope(token.Context());
+        return a * b;
+      },
+      executor);
+}
+
+// BigInteger::Pow (token polled before every squaring)
+inline Operation<BigInteger> pow(BigInteger value, cs_int32 exponent,
+                                 CancellationToken token = CancellationToken(),
+                                 Executor& executor = Executor::Default()) {
+  return Operation<BigInteger>(
+      [value = std::move(value), exponent, token]() {
+        BigIntegerContext::Scope scope(token.Context());
+        return BigInteger::Pow(value, exponent);
+      },
+      executor);
+}
+
+// ToString(base); base 10 goes through WriteDecimal (token polled between
+// blocks). empty string on Error() or cancellation
+inline Operation<std::string> toString(
+    BigInteger value, int base = 10,
+    CancellationToken token = CancellationToken(),
+    Executor& executor = Executor::Default()) {
+  return Operation<std::string>(
+      [value = std::move(value), base, token]() {
+        if (token.IsCancelled() || value.IsError()) return std::string();
+        if (base != 10) return value.ToString(base);
+        BigIntegerContext::Scope scope(token.Context());
+        std::ostringstream os;
+        value.WriteDecimal(os);
+        if (!os) return std::string();  // cancelled
+        return os.str();
+      },
+      executor);
+}
+
+}  // namespace async
+
+}  // namespace csbiginteger
+
+#endif  // __cpp_impl_coroutine
+
+#endif  // CS_BIGINTEGER_ASYNC_HPP
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier:  MIT
+// Copyright (C) 2020-2022 - csbiginteger-cpp project
+
+#ifndef CS_BIGINTEGER_CONTEXT_HPP
+#define CS_BIGINTEGER_CONTEXT_HPP
+
+// c++
+#include <atomic>
+#include <cstddef>
+#include <functional>
+
+namespace csbiginteger {
+
+// progress reporting and cooperative cancellation of long computations.
+// installed on the computing thread with BigIntegerContext::Scope; long
+// algorithms (limb multiplication, radix conversion, WriteDecimal and Pow)
+// poll it at chunk boundaries and stop once cancelled: Pow, PowerOf10 and
+// engine *, / and % give Error(), ToChars/FromChars give
+// errc::operation_canceled and WriteDecimal sets failbit. Engine *, / and %
+// of operands with Limbs::POLL_LIMBS limbs or more run on the (slower) limb
+// kernels while a scope is installed. Without a scope, polling is a
+// thread-local load.
+// Threads started by the library (nthreads > 1) do not inherit the scope.
+class BigIntegerContext {
+ public:
+  // progress(phase, done, total), called on the computing thread:
+  //   "pow": exponent bits, "to_chars" and "from_chars": chunks of digits,
+  //   "write_decimal": digit blocks
+  std::function<void(const char* phase, size_t done, size_t total)> progress;
+
+  // may be called from any thread
+  void Cancel() { cancelled.store(true, std::memory_order_relaxed); }
+
+  bool IsCancelled() const {
+    return cancelled.load(std::memory_order_relaxed);
+  }
+
+  // context of calling thread (nullptr when none)
+  static BigIntegerContext* Current() { return current(); }
+
+  // current context was cancelled
+  static bool Cancelled() {
+    BigIntegerContext* c = current();
+    return (c != nullptr) && c->IsCancelled();
+  }
+
+  // reports progress to current context, false once cancelled
+  static bool Poll(const char* phase, size_t done, size_t total) {
+    BigIntegerContext* c = current();
+    if (c == nullptr) return true;
+    if (c->progress) c->progress(phase, done, total);
+    return !c->IsCancelled();
+  }
+
+  // RAII helper: installs 'ctx' on this thread (nullptr disables polling)
+  class Scope final {
+   private:
+    BigIntegerContext* _old;
+
+   public:
+    explicit Scope(BigIntegerContext* ctx) : _old(current()) {
+      current() = ctx;
+    }
+    ~Scope() { current() = _old; }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+  };
+
+ private:
+  std::atomic<bool> cancelled{false};
+
+  static BigIntegerContext*& current() {
+    static thread_local BigIntegerContext* c = nullptr;
+    return c;
+  }
+};
+
+}  // namespace csbiginteger
+
+#endif  // CS_BIGINTEGER_CONTEXT_HPP
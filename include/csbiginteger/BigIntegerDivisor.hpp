@@ -0,0 +1,306 @@
+// SPDX-License-Identifier:  MIT
+// Copyright (C) 2020-2022 - csbiginteger-cpp project
+
+#ifndef CS_BIGINTEGER_DIVISOR_HPP
+#define CS_BIGINTEGER_DIVISOR_HPP
+
+// c++
+#include <algorithm>
+#include <vector>
+
+// internal classes
+#include <csbiginteger/BigInteger.h>
+#include <csbiginteger/Helper.hpp>
+#include <csbiginteger/Limbs.hpp>
+
+namespace csbiginteger {
+
+// Division by an invariant divisor (10^decimals, a fee denominator, a
+// modulus), with its reciprocal computed once:
+// - one limb: normalized divisor and its Moller-Granlund reciprocal
+//   v = floor((B^2 - 1) / d) - B, so each limb of the dividend takes two
+//   multiplications instead of a hardware division
+// - n limbs: Barrett reciprocal mu = floor((B^2n - 1) / d), so each n limbs
+//   of the dividend take two partial limb multiplications (about n^2 limb
+//   products in total) and a few corrections
+// - above MAX_LIMBS: one engine division (remainder is x - q * d), since
+//   quadratic reduction no longer beats engine division there
+// Results match operator/ (truncated) and operator% (sign of dividend),
+// without engine calls after construction (up to MAX_LIMBS). Methods are
+// const (scratch buffers are thread-local), so one divisor may be shared
+// by threads.
+//
+// Example:
+//   static const BigIntegerDivisor unit(BigInteger::PowerOf10(18));
+//   BigInteger cents;
+//   BigInteger whole = unit.DivRem(amount, cents);
+class BigIntegerDivisor final {
+ public:
+  // largest divisor (in limbs) reduced by the limb kernel
+  static constexpr size_t MAX_LIMBS = 64;
+
+ private:
+  BigInteger value;
+  bool negative{false};
+  cs_vlimb d;    // magnitude (single limb is normalized)
+  cs_vlimb mu;   // Barrett reciprocal (n + 1 limbs)
+  int shift{0};  // normalization of single limb
+  cs_limb v{0};  // Moller-Granlund reciprocal of single limb
+
+ public:
+  // Error() or zero give IsError() (and Error() results)
+  explicit BigIntegerDivisor(const BigInteger& divisor) : value(divisor) {
+    if (divisor.IsError() || divisor.IsZero()) {
+      value = BigInteger::Error();
+      return;
+    }
+    cs_vbyte mag;
+    negative = Helper::toMagnitude(divisor._data.data(), divisor._data.size(),
+                                   mag);
+    Limbs::fromBytes(mag.data(), mag.size(), d);
+    size_t n = d.size();
+    if (n > MAX_LIMBS) return;  // engine division
+    if (n == 1) {
+      while ((d[0] << shift) >> (Limbs::BITS - 1) == 0) shift++;
+      d[0] <<= shift;
+      v = static_cast<cs_limb>(~cs_dlimb{0} / d[0] -
+                               (cs_dlimb{1} << Limbs::BITS));
+      return;
+    }
+    // engine division, only once: (B^2n - 1) / d still fits n + 1 limbs
+    // when d = B^(n-1) (and keeps Barrett error below 3)
+    BigInteger b2n = BigInteger::One()
+                     << static_cast<cs_int64>(2 * n * Limbs::BITS);
+    BigInteger r = (b2n - BigInteger::One()) / BigInteger::Abs(divisor);
+    Helper::toMagnitude(r._data.data(), r._data.size(), mag);
+    Limbs::fromBytes(mag.data(), mag.size(), mu);
+    mu.resize(n + 1, 0);
+  }
+
+  bool IsError() const { return value.IsError(); }
+
+  const BigInteger& Value() const { return value; }
+
+  // x / divisor (truncated), remainder (sign of x) in 'remainder'
+  BigInteger DivRem(const BigInteger& x, BigInteger& remainder) const {
+    BigInteger q;
+    divRem(x, &q, &remainder);
+    return q;
+  }
+
+  BigInteger Divide(const BigInteger& x) const {
+    BigInteger q;
+    divRem(x, &q, nullptr);
+    return q;
+  }
+
+  BigInteger Remainder(const BigInteger& x) const {
+    BigInteger r;
+    divRem(x, nullptr, &r);
+    return r;
+  }
+
+ private:
+  struct Scratch {
+    cs_vbyte bytes;
+    cs_vlimb x;
+    cs_vlimb q;
+    cs_vlimb y;  // block and remainder (Barrett)
+    cs_vlimb t;  // products (Barrett)
+  };
+
+  static Scratch& scratch() {
+    static thread_local Scratch s;
+    return s;
+  }
+
+  void divRem(const BigInteger& x, BigInteger* q, BigInteger* r) const {
+    if (value._data.empty() || x._data.empty()) {  // Error()
+      if (q != nullptr) *q = BigInteger::Error();
+      if (r != nullptr) *r = BigInteger::Error();
+      return;
+    }
+    if (d.size() > MAX_LIMBS) {
+      BigInteger quotient = x / value;
+      if (r != nullptr) *r = x - quotient * value;
+      if (q != nullptr) *q = std::move(quotient);
+      return;
+    }
+    Scratch& s = scratch();
+    bool xneg = load(x._data, s);
+    if (d.size() == 1)
+      divRem1(s);
+    else
+      divRemN(s);
+    // s.q is quotient, s.x is remainder
+    if (q != nullptr) store(s.q, xneg != negative, s, q->_data);
+    if (r != nullptr) store(s.x, xneg, s, r->_data);
+  }
+
+  // magnitude of two's complement bytes into s.x, returns sign
+  template <class VByte>
+  static bool load(const VByte& data, Scratch& s) {
+    if (data[0] & 0x80) {
+      Helper::toMagnitude(data.data(), data.size(), s.bytes);
+      Limbs::fromBytes(s.bytes.data(), s.bytes.size(), s.x);
+      return true;
+    }
+    // non-negative: limbs straight from bytes
+    constexpr size_t S = sizeof(cs_limb);
+    size_t n = data.size();
+    s.x.resize((n + S - 1) / S);
+    for (size_t k = 0; k < s.x.size(); k++) {
+      size_t end = n - k * S;
+      cs_limb l = 0;
+      for (size_t i = (end > S) ? end - S : 0; i < end; i++)
+        l = (l << 8) | data[i];
+      s.x[k] = l;
+    }
+    Limbs::trim(s.x);
+    return false;
+  }
+
+  // two's complement bytes of (signed) magnitude
+  template <class VByte>
+  static void store(const cs_vlimb& mag, bool neg, Scratch& s, VByte& data) {
+    if (neg && !mag.empty()) {
+      Limbs::toBytes(mag, s.bytes);
+      Helper::fromMagnitude(s.bytes.data(), s.bytes.size(), true, data);
+      return;
+    }
+    if (mag.empty()) {
+      data.assign(1, 0x00);
+      return;
+    }
+    // non-negative: bytes straight from limbs (zero byte when top bit is set)
+    constexpr size_t S = sizeof(cs_limb);
+    cs_limb top = mag.back();
+    size_t topBytes = 0;
+    while ((topBytes < S) && ((top >> (8 * topBytes)) != 0)) topBytes++;
+    bool pad = (top >> (8 * topBytes - 1)) & 1;
+    size_t n = pad + topBytes + (mag.size() - 1) * S;
+    data.resize(n);
+    if (pad) data[0] = 0x00;
+    for (size_t i = 0; i < n - pad; i++)
+      data[n - 1 - i] = static_cast<cs_byte>(mag[i / S] >> (8 * (i % S)));
+  }
+
+  // (u1, u0) = q * d + r, with u1 < d (Moller-Granlund, algorithm 4)
+  cs_limb div2by1(cs_limb u1, cs_limb u0, cs_limb& r) const {
+    cs_dlimb p = static_cast<cs_dlimb>(v) * u1 +
+                 ((static_cast<cs_dlimb>(u1) << Limbs::BITS) | u0);
+    cs_limb q1 = static_cast<cs_limb>(p >> Limbs::BITS) + 1;
+    cs_limb q0 = static_cast<cs_limb>(p);
+    r = u0 - q1 * d[0];
+    if (r > q0) {
+      q1--;
+      r += d[0];
+    }
+    if (r >= d[0]) {  // unlikely
+      q1++;
+      r -= d[0];
+    }
+    return q1;
+  }
+
+  // s.x / d: dividend limbs are shifted as divisor on the fly
+  void divRem1(Scratch& s) const {
+    const cs_vlimb& x = s.x;
+    size_t n = x.size();
+    s.q.assign(n + 1, 0);
+    cs_limb rem = 0;
+    for (size_t i = n + 1; i-- > 0;) {
+      cs_limb u = (i < n) ? (x[i] << shift) : 0;
+      if ((shift != 0) && (i > 0)) u |= x[i - 1] >> (Limbs::BITS - shift);
+      s.q[i] = div2by1(rem, u, rem);
+    }
+    Limbs::trim(s.q);
+    s.x.assign(1, rem >> shift);
+    Limbs::trim(s.x);
+  }
+
+  // s.x / d by blocks of n limbs (from the most significant): each step
+  // divides y = rem * B^n + block (< d * B^n) with Barrett reduction
+  void divRemN(Scratch& s) const {
+    size_t n = d.size();
+    size_t blocks = (s.x.size() + n - 1) / n;
+    s.x.resize(blocks * n, 0);
+    s.q.assign(blocks * n, 0);
+    s.y.assign(2 * n, 0);
+    s.t.resize(3 * n + 3);
+    for (size_t k = blocks; k-- > 0;) {
+      std::copy(s.y.begin(), s.y.begin() + n, s.y.begin() + n);  // rem
+      std::copy(s.x.begin() + k * n, s.x.begin() + (k + 1) * n, s.y.begin());
+      barrett(s.y.data(), s.q.data() + k * n, s.t.data());
+    }
+    Limbs::trim(s.q);
+    s.x.assign(s.y.begin(), s.y.begin() + n);
+    Limbs::trim(s.x);
+  }
+
+  // y[0..2n) < d * B^n: q[0..n) = y / d and y[0..n) = y % d (HAC 14.42).
+  // products are partial (HAC 14.44): q1 * mu without columns below n - 1
+  // and q3 * d without limbs above n, so q3 may be 4 below y / d.
+  // t has 3n + 3 limbs
+  void barrett(cs_limb* y, cs_limb* q, cs_limb* t) const {
+    size_t n = d.size();
+    cs_limb* q2 = t;             // q1 * mu (2n + 2 limbs)
+    cs_limb* p = t + 2 * n + 2;  // q3 * d mod B^(n+1)
+    mulHigh(y + n - 1, mu.data(), n + 1, n - 1, q2);
+    cs_limb* q3 = q2 + n + 1;  // q3 <= y / d < B^n
+    mulLow(q3, n + 1, d.data(), n, n + 1, p);
+    // y - q3 * d < 5d < B^(n+1): low n + 1 limbs are enough (wrapping)
+    Limbs::sub(y, n + 1, p, n + 1);
+    while (!below(y, n + 1)) {
+      Limbs::sub(y, n + 1, d.data(), n);
+      cs_limb one = 1;
+      Limbs::add(q3, n + 1, &one, 1);
+    }
+    std::copy(q3, q3 + n, q);
+  }
+
+  // r[0..2m) = a * b (a and b of m limbs), columns below 'c' skipped
+  static void mulHigh(const cs_limb* a, const cs_limb* b, size_t m, size_t c,
+                      cs_limb* r) {
+    std::fill(r, r + 2 * m, 0);
+    for (size_t j = 0; j < m; j++) {
+      cs_limb carry = 0;
+      for (size_t i = (c > j) ? c - j : 0; i < m; i++) {
+        cs_dlimb t = static_cast<cs_dlimb>(a[i]) * b[j] + r[i + j] + carry;
+        r[i + j] = static_cast<cs_limb>(t);
+        carry = static_cast<cs_limb>(t >> Limbs::BITS);
+      }
+      r[m + j] = carry;
+    }
+  }
+
+  // r[0..m) = a * b mod B^m
+  static void mulLow(const cs_limb* a, size_t na, const cs_limb* b, size_t nb,
+                     size_t m, cs_limb* r) {
+    std::fill(r, r + m, 0);
+    for (size_t j = 0; (j < nb) && (j < m); j++) {
+      cs_limb carry = 0;
+      size_t end = std::min(na, m - j);
+      for (size_t i = 0; i < end; i++) {
+        cs_dlimb t = static_cast<cs_dlimb>(a[i]) * b[j] + r[i + j] + carry;
+        r[i + j] = static_cast<cs_limb>(t);
+        carry = static_cast<cs_limb>(t >> Limbs::BITS);
+      }
+      if (end + j < m) r[end + j] = carry;
+    }
+  }
+
+  // y[0..m) < d
+  bool below(const cs_limb* y, size_t m) const {
+    size_t n = d.size();
+    for (size_t i = m; i-- > n;)
+      if (y[i] != 0) return false;
+    for (size_t i = n; i-- > 0;)
+      if (y[i] != d[i]) return y[i] < d[i];
+    return false;
+  }
+};
+
+}  // namespace csbiginteger
+
+#endif  // CS_BIGINTEGER_DIVISOR_HPP
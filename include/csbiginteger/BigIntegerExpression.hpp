@@ -0,0 +1,487 @@
+// SPDX-License-Identifier:  MIT
+// Copyright (C) 2020-2022 - csbiginteger-cpp project
+
+#ifndef CS_BIGINTEGER_EXPRESSION_HPP
+#define CS_BIGINTEGER_EXPRESSION_HPP
+
+// c++
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// internal classes
+#include <csbiginteger/BigInteger.h>
+#include <csbiginteger/Reduction.hpp>
+
+namespace csbiginteger {
+
+// Expression compiled once to register bytecode, then evaluated over many
+// inputs (scalar arguments or columns, optionally on several threads).
+//
+// Infix syntax: integer literals (decimal or 0x hex), variables, unary '-',
+// '*', '/', '%', '+', '-', '<<', '>>' (C precedence), parentheses, and
+// functions abs(x), min(x, y), max(x, y) and pow(x, k).
+// RPN syntax: space separated literals, variables and operators (same ones,
+// plus 'neg', 'abs', 'min', 'max' and 'pow').
+//
+// Operands are read in place from inputs, constants or registers (no loads).
+// Constant subexpressions are folded, shift and pow amounts that are
+// constants become immediates, and registers are reused as soon as their
+// value is consumed. Errors follow BigInteger (e.g. division by zero gives
+// Error()), and shift counts or pow exponents outside int32 give Error().
+//
+// Example:
+//   BigIntegerExpression expr;
+//   BigIntegerExpression::Compile("(a * rate) / 10000 + bonus",
+//                                 {"a", "rate", "bonus"}, expr);
+//   std::vector<BigInteger> out = expr.Evaluate({as, rates, bonuses}, 0);
+class BigIntegerExpression final {
+ public:
+  enum class Op : cs_byte {
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Mod,
+    Shl,
+    Shr,
+    Neg,  // unary
+    Abs,  // unary
+    Min,
+    Max,
+    Pow
+  };
+
+  // dst = op(a, b). operands: [0, nvars) inputs, then constants, then
+  // registers. 'imm' replaces 'b' on Shl, Shr and Pow when 'useImm'
+  struct Instr {
+    Op op;
+    bool useImm;
+    cs_int32 imm;
+    int dst;
+    int a;
+    int b;
+  };
+
+ private:
+  size_t nvars{0};
+  std::vector<BigInteger> consts;
+  size_t nregs{0};
+  std::vector<Instr> code;
+  int result{-1};  // operand holding the value
+
+  // syntax tree (compilation only)
+  struct Node {
+    int op;       // Op, or -1 for a leaf
+    int operand;  // leaf: input or constant
+    int left;
+    int right;
+  };
+
+  struct Compiler {
+    std::string_view src;
+    const std::vector<std::string>& vars;
+    BigIntegerExpression& expr;
+    std::vector<Node> nodes;
+    const char* p;
+    std::vector<int> freeRegs;
+  };
+
+ public:
+  // infix source over 'vars' (names of inputs, in argument order). returns
+  // end of source, or {position, errc::invalid_argument} of the first error
+  // ('expr' is only changed on success)
+  static std::from_chars_result Compile(std::string_view src,
+                                        const std::vector<std::string>& vars,
+                                        BigIntegerExpression& expr) {
+    BigIntegerExpression e;
+    e.nvars = vars.size();
+    Compiler c{src, vars, e, {}, src.data(), {}};
+    int root = parseShift(c);
+    skipSpaces(c);
+    if ((root < 0) || (c.p != src.data() + src.size()))
+      return {c.p, std::errc::invalid_argument};
+    e.finish(c, root);
+    expr = std::move(e);
+    return {c.p, std::errc()};
+  }
+
+  // as Compile, on RPN source
+  static std::from_chars_result CompileRPN(std::string_view src,
+                                           const std::vector<std::string>& vars,
+                                           BigIntegerExpression& expr) {
+    BigIntegerExpression e;
+    e.nvars = vars.size();
+    Compiler c{src, vars, e, {}, src.data(), {}};
+    const char* last = src.data() + src.size();
+    std::vector<int> stack;
+    for (skipSpaces(c); c.p != last; skipSpaces(c)) {
+      const char* tok = c.p;
+      while ((c.p != last) && (*c.p != ' ') && (*c.p != '\t')) c.p++;
+      std::string_view t(tok, c.p - tok);
+      int op = rpnOp(t);
+      if (op < 0) {
+        c.p = tok;
+        int leaf = parseLeaf(c);
+        if ((leaf < 0) || (c.p != tok + t.size()))
+          return {tok, std::errc::invalid_argument};
+        stack.push_back(leaf);
+        continue;
+      }
+      bool unary = (op == static_cast<int>(Op::Neg)) ||
+                   (op == static_cast<int>(Op::Abs));
+      size_t arity = unary ? 1 : 2;
+      if (stack.size() < arity) return {tok, std::errc::invalid_argument};
+      int right = (arity == 2) ? stack.back() : -1;
+      if (arity == 2) stack.pop_back();
+      int left = stack.back();
+      stack.back() = node(c, op, -1, left, right);
+    }
+    if (stack.size() != 1) return {c.p, std::errc::invalid_argument};
+    e.finish(c, stack[0]);
+    expr = std::move(e);
+    return {c.p, std::errc()};
+  }
+
+  size_t Variables() const { return nvars; }
+
+  size_t Registers() const { return nregs; }
+
+  const std::vector<Instr>& Code() const { return code; }
+
+  // value for one set of arguments (Error() when count does not match)
+  BigInteger Evaluate(const std::vector<BigInteger>& args) const {
+    if ((args.size() != nvars) || (result < 0)) return BigInteger::Error();
+    std::vector<const BigInteger*> in(nvars);
+    for (size_t v = 0; v < nvars; v++) in[v] = &args[v];
+    std::vector<BigInteger> slots = consts;
+    slots.resize(consts.size() + nregs);
+    return run(in.data(), slots);
+  }
+
+  // out[i] = value for columns[0][i], columns[1][i], ... (one column per
+  // variable, same sizes; empty result otherwise). rows are split across
+  // 'nthreads' threads (0 means hardware concurrency), each one with its
+  // own registers, reused for all of its rows
+  std::vector<BigInteger> Evaluate(
+      const std::vector<std::vector<BigInteger>>& columns,
+      unsigned nthreads = 1) const {
+    std::vector<BigInteger> out;
+    if ((columns.size() != nvars) || (result < 0)) return out;
+    size_t n = (nvars == 0) ? 1 : columns[0].size();
+    for (const auto& col : columns)
+      if (col.size() != n) return out;
+    out.resize(n);
+    BigInteger* first = out.data();
+    ReductionParts(first, n, ReductionThreads(n, nthreads),
+                   [this, &columns, first](BigInteger* begin, BigInteger* end,
+                                           unsigned) {
+                     std::vector<const BigInteger*> in(nvars);
+                     std::vector<BigInteger> slots = consts;
+                     slots.resize(consts.size() + nregs);
+                     for (BigInteger* it = begin; it != end; ++it) {
+                       size_t row = it - first;
+                       for (size_t v = 0; v < nvars; v++)
+                         in[v] = &columns[v][row];
+                       *it = run(in.data(), slots);
+                     }
+                   });
+    return out;
+  }
+
+ private:
+  // executes code over inputs 'in' ('slots' holds constants and registers)
+  BigInteger run(const BigInteger* const* in,
+                 std::vector<BigInteger>& slots) const {
+    size_t base = nvars;
+    auto at = [in, &slots, base](int o) -> const BigInteger& {
+      return (static_cast<size_t>(o) < base) ? *in[o] : slots[o - base];
+    };
+    for (const Instr& i : code) {
+      const BigInteger& a = at(i.a);
+      BigInteger& dst = slots[i.dst - base];
+      switch (i.op) {
+        case Op::Add:
+          dst = a + at(i.b);
+          break;
+        case Op::Sub:
+          dst = a - at(i.b);
+          break;
+        case Op::Mul:
+          dst = a * at(i.b);
+          break;
+        case Op::Div:
+          dst = a / at(i.b);
+          break;
+        case Op::Mod:
+          dst = a % at(i.b);
+          break;
+        case Op::Shl:
+        case Op::Shr: {
+          cs_int32 n = i.imm;
+          if (!i.useImm && !count(at(i.b), n))
+            dst = BigInteger::Error();
+          else
+            dst = (i.op == Op::Shl) ? (a << n) : (a >> n);
+          break;
+        }
+        case Op::Neg:
+          dst = -a;
+          break;
+        case Op::Abs:
+          dst = BigInteger::Abs(a);
+          break;
+        case Op::Min:
+          dst = BigInteger::Min(a, at(i.b));
+          break;
+        case Op::Max:
+          dst = BigInteger::Max(a, at(i.b));
+          break;
+        case Op::Pow: {
+          cs_int32 n = i.imm;
+          if (!i.useImm && !count(at(i.b), n))
+            dst = BigInteger::Error();
+          else
+            dst = BigInteger::Pow(a, n);
+          break;
+        }
+      }
+    }
+    return at(result);
+  }
+
+  // 'v' as int32 shift count or exponent (false when out of range: engine
+  // shifts and Pow would truncate it)
+  static bool count(const BigInteger& v, cs_int32& n) {
+    cs_int64 w;
+    if (!v.TryToInt64(w) || (w != static_cast<cs_int32>(w))) return false;
+    n = static_cast<cs_int32>(w);
+    return true;
+  }
+
+  // constant folding, then register allocation over the tree
+  void finish(Compiler& c, int root) {
+    fold(c, root);
+    result = emit(c, root);
+  }
+
+  bool isConst(int operand) const {
+    return (operand >= static_cast<int>(nvars)) &&
+           (operand < static_cast<int>(nvars + consts.size()));
+  }
+
+  void fold(Compiler& c, int n) {
+    Node& nd = c.nodes[n];
+    if (nd.op < 0) return;
+    fold(c, nd.left);
+    if (nd.right >= 0) fold(c, nd.right);
+    const Node& l = c.nodes[nd.left];
+    bool leftConst = (l.op < 0) && isConst(l.operand);
+    bool rightConst = (nd.right < 0) || ((c.nodes[nd.right].op < 0) &&
+                                         isConst(c.nodes[nd.right].operand));
+    if (!leftConst || !rightConst) return;
+    // evaluate node alone (constants as inputs)
+    BigIntegerExpression one;
+    Instr i{static_cast<Op>(nd.op), false, 0, 2, 0, 1};
+    one.nvars = 2;
+    one.nregs = 1;
+    one.code.push_back(i);
+    one.result = 2;
+    std::vector<BigInteger> args{consts[l.operand - nvars]};
+    args.push_back((nd.right < 0)
+                       ? BigInteger::Zero()
+                       : consts[c.nodes[nd.right].operand - nvars]);
+    nd.op = -1;
+    nd.operand = constant(one.Evaluate(args));
+  }
+
+  // operand holding value of node 'n' (registers released when consumed)
+  int emit(Compiler& c, int n) {
+    Node nd = c.nodes[n];
+    if (nd.op < 0) return nd.operand;
+    int a = emit(c, nd.left);
+    Instr i{static_cast<Op>(nd.op), false, 0, -1, a, -1};
+    if (nd.right >= 0) {
+      const Node& r = c.nodes[nd.right];
+      bool immOp = (i.op == Op::Shl) || (i.op == Op::Shr) || (i.op == Op::Pow);
+      cs_int64 v;
+      if (immOp && (r.op < 0) && isConst(r.operand) &&
+          consts[r.operand - nvars].TryToInt64(v) &&
+          (v == static_cast<cs_int32>(v))) {
+        i.useImm = true;
+        i.imm = static_cast<cs_int32>(v);
+      } else {
+        i.b = emit(c, nd.right);
+      }
+    }
+    release(c, i.b);
+    release(c, a);
+    i.dst = allocate(c);
+    code.push_back(i);
+    return i.dst;
+  }
+
+  int allocate(Compiler& c) {
+    if (c.freeRegs.empty())
+      return static_cast<int>(nvars + consts.size() + nregs++);
+    int r = c.freeRegs.back();
+    c.freeRegs.pop_back();
+    return r;
+  }
+
+  void release(Compiler& c, int operand) {
+    if (operand >= static_cast<int>(nvars + consts.size()))
+      c.freeRegs.push_back(operand);
+  }
+
+  // constants are placed before registers: only added before emission
+  int constant(const BigInteger& value) {
+    consts.push_back(value);
+    return static_cast<int>(nvars + consts.size() - 1);
+  }
+
+  // ---------- parsing ----------
+
+  static int node(Compiler& c, int op, int operand, int left, int right) {
+    c.nodes.push_back(Node{op, operand, left, right});
+    return static_cast<int>(c.nodes.size() - 1);
+  }
+
+  static void skipSpaces(Compiler& c) {
+    const char* last = c.src.data() + c.src.size();
+    while ((c.p != last) && ((*c.p == ' ') || (*c.p == '\t'))) c.p++;
+  }
+
+  static bool accept(Compiler& c, std::string_view tok) {
+    skipSpaces(c);
+    const char* last = c.src.data() + c.src.size();
+    if (static_cast<size_t>(last - c.p) < tok.size()) return false;
+    if (std::string_view(c.p, tok.size()) != tok) return false;
+    c.p += tok.size();
+    return true;
+  }
+
+  static bool isName(char ch, bool first) {
+    return ((ch >= 'a') && (ch <= 'z')) || ((ch >= 'A') && (ch <= 'Z')) ||
+           (ch == '_') || (!first && (ch >= '0') && (ch <= '9'));
+  }
+
+  static int rpnOp(std::string_view t) {
+    static const char* names[] = {"+",   "-",   "*",   "/",   "%",   "<<",
+                                  ">>",  "neg", "abs", "min", "max", "pow"};
+    for (int op = 0; op < 12; op++)
+      if (t == names[op]) return op;
+    return -1;
+  }
+
+  // literal or variable (-1 on error)
+  static int parseLeaf(Compiler& c) {
+    skipSpaces(c);
+    const char* last = c.src.data() + c.src.size();
+    const char* start = c.p;
+    if ((c.p != last) && (*c.p >= '0') && (*c.p <= '9')) {
+      int base = 10;
+      if ((last - c.p > 2) && (c.p[0] == '0') && (c.p[1] == 'x')) {
+        base = 16;
+        c.p += 2;
+      }
+      BigInteger value;
+      std::from_chars_result r = BigInteger::FromChars(c.p, last, value, base);
+      if (r.ec != std::errc()) {
+        c.p = start;
+        return -1;
+      }
+      c.p = r.ptr;
+      return node(c, -1, c.expr.constant(value), -1, -1);
+    }
+    while ((c.p != last) && isName(*c.p, c.p == start)) c.p++;
+    std::string_view name(start, c.p - start);
+    for (size_t v = 0; v < c.vars.size(); v++)
+      if (name == c.vars[v]) return node(c, -1, static_cast<int>(v), -1, -1);
+    c.p = start;
+    return -1;
+  }
+
+  static int parsePrimary(Compiler& c) {
+    if (accept(c, "(")) {
+      int n = parseShift(c);
+      if ((n < 0) || !accept(c, ")")) return -1;
+      return n;
+    }
+    if (accept(c, "-")) {
+      int n = parsePrimary(c);
+      return (n < 0) ? -1 : node(c, static_cast<int>(Op::Neg), -1, n, -1);
+    }
+    static const std::pair<const char*, Op> functions[] = {
+        {"abs(", Op::Abs}, {"min(", Op::Min}, {"max(", Op::Max},
+        {"pow(", Op::Pow}};
+    for (const auto& f : functions) {
+      if (!accept(c, f.first)) continue;
+      int left = parseShift(c);
+      int right = -1;
+      if ((left >= 0) && (f.second != Op::Abs))
+        right = accept(c, ",") ? parseShift(c) : -1;
+      if ((left < 0) || ((f.second != Op::Abs) && (right < 0)) ||
+          !accept(c, ")"))
+        return -1;
+      return node(c, static_cast<int>(f.second), -1, left, right);
+    }
+    return parseLeaf(c);
+  }
+
+  static int parseTerm(Compiler& c) {
+    int n = parsePrimary(c);
+    while (n >= 0) {
+      Op op;
+      if (accept(c, "*"))
+        op = Op::Mul;
+      else if (accept(c, "/"))
+        op = Op::Div;
+      else if (accept(c, "%"))
+        op = Op::Mod;
+      else
+        break;
+      int r = parsePrimary(c);
+      n = (r < 0) ? -1 : node(c, static_cast<int>(op), -1, n, r);
+    }
+    return n;
+  }
+
+  static int parseSum(Compiler& c) {
+    int n = parseTerm(c);
+    while (n >= 0) {
+      Op op;
+      if (accept(c, "+"))
+        op = Op::Add;
+      else if (accept(c, "-"))
+        op = Op::Sub;
+      else
+        break;
+      int r = parseTerm(c);
+      n = (r < 0) ? -1 : node(c, static_cast<int>(op), -1, n, r);
+    }
+    return n;
+  }
+
+  static int parseShift(Compiler& c) {
+    int n = parseSum(c);
+    while (n >= 0) {
+      Op op;
+      if (accept(c, "<<"))
+        op = Op::Shl;
+      else if (accept(c, ">>"))
+        op = Op::Shr;
+      else
+        break;
+      int r = parseSum(c);
+      n = (r < 0) ? -1 : node(c, static_cast<int>(op), -1, n, r);
+    }
+    return n;
+  }
+};
+
+}  // namespace csbiginteger
+
+#endif  // CS_BIGINTEGER_EXPRESSION_HPP
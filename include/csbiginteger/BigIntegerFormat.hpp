@@ -0,0 +1,200 @@
+// SPDX-License-Identifier:  MIT
+// Copyright (C) 2020-2022 - csbiginteger-cpp project
+
+#ifndef CS_BIGINTEGER_FORMAT_HPP
+#define CS_BIGINTEGER_FORMAT_HPP
+
+// c++
+#include <charconv>
+#include <vector>
+
+// internal classes
+#include <csbiginteger/BigInteger.h>
+
+// std::format (c++20 library) and fmt support (when fmt is included before
+// this header, or CSBIGINTEGER_FMT is defined)
+#if __has_include(<format>)
+#include <format>
+#endif
+#if defined(CSBIGINTEGER_FMT) && !defined(FMT_VERSION)
+#include <fmt/format.h>
+#endif
+
+namespace csbiginteger {
+
+// format specification: [[fill]align][sign][#][0][width][grouping][type]
+//   align: '<', '>' (default) or '^'
+//   sign: '-' (default), '+' or ' '
+//   '#': radix prefix (0x, 0X, 0b, 0B or 0)
+//   '0': zero padding after sign and prefix (when no align is given)
+//   grouping: ',' (thousands, type 'd' only) or '_' (3 digits on 'd', 4 on
+//             other types)
+//   type: 'd' (default), 'x', 'X', 'b', 'B' or 'o'
+// digits are signed magnitude (as ToChars), so {:x} of -255 is "-ff".
+// Error() is written as empty digits.
+struct BigIntegerFormatSpec {
+  char fill{' '};
+  char align{'\0'};
+  char sign{'-'};
+  bool alt{false};
+  bool zero{false};
+  size_t width{0};
+  char group{'\0'};
+  char type{'d'};
+
+  // parses [first, last) up to '}' (or last), as std::from_chars: returns
+  // end of spec, or errc::invalid_argument
+  constexpr std::from_chars_result parse(const char* first, const char* last) {
+    const char* p = first;
+    auto isAlign = [](char c) {
+      return (c == '<') || (c == '>') || (c == '^');
+    };
+    if ((last - p >= 2) && (p[0] != '}') && isAlign(p[1])) {
+      fill = p[0];
+      align = p[1];
+      p += 2;
+    } else if ((p != last) && isAlign(*p)) {
+      align = *p++;
+    }
+    if ((p != last) && ((*p == '+') || (*p == '-') || (*p == ' '))) sign = *p++;
+    alt = (p != last) && (*p == '#');
+    if (alt) p++;
+    zero = (p != last) && (*p == '0');
+    if (zero) p++;
+    for (; (p != last) && (*p >= '0') && (*p <= '9'); p++)
+      width = width * 10 + (*p - '0');
+    if ((p != last) && ((*p == ',') || (*p == '_'))) group = *p++;
+    if ((p != last) && (*p != '}')) type = *p++;
+    switch (type) {
+      case 'd':
+      case 'x':
+      case 'X':
+      case 'b':
+      case 'B':
+      case 'o':
+        break;
+      default:
+        return {first, std::errc::invalid_argument};
+    }
+    if ((group == ',') && (type != 'd'))
+      return {first, std::errc::invalid_argument};
+    if ((p != last) && (*p != '}')) return {first, std::errc::invalid_argument};
+    return {p, std::errc()};
+  }
+
+  int radix() const {
+    switch (type) {
+      case 'x':
+      case 'X':
+        return 16;
+      case 'b':
+      case 'B':
+        return 2;
+      case 'o':
+        return 8;
+      default:
+        return 10;
+    }
+  }
+
+  // writes 'big' to 'out' (digits produced by ToChars, on a stack buffer
+  // unless value is large)
+  template <class OutIt>
+  OutIt write(const BigInteger& big, OutIt out) const {
+    int base = radix();
+    int bits = 1;  // bits per digit (at least)
+    while ((2 << bits) <= base) bits++;
+    size_t cap = 2 + (8 * static_cast<size_t>(big.Length()) + bits - 1) / bits;
+    char small[128];
+    std::vector<char> large;
+    char* buf = small;
+    if (cap > sizeof(small)) {
+      large.resize(cap);
+      buf = large.data();
+    }
+    std::to_chars_result r = big.ToChars(buf, buf + cap, base);
+    const char* digits = buf;
+    const char* end = (r.ec == std::errc()) ? r.ptr : buf;
+    bool negative = (digits != end) && (*digits == '-');
+    if (negative) digits++;
+    // sign, prefix, digits and separators
+    char signChar = negative ? '-' : ((sign == '-') ? '\0' : sign);
+    const char* prefix = "";
+    if (alt) {
+      if (base == 16) prefix = (type == 'X') ? "0X" : "0x";
+      if (base == 2) prefix = (type == 'B') ? "0B" : "0b";
+      if (base == 8) prefix = "0";
+    }
+    size_t plen = 0;
+    while (prefix[plen] != '\0') plen++;
+    size_t ndigits = end - digits;
+    size_t every = (base == 10) ? 3 : 4;
+    bool grouped = (group != '\0') && (ndigits > 0);
+    size_t nseps = grouped ? (ndigits - 1) / every : 0;
+    size_t len = (signChar != '\0') + plen + ndigits + nseps;
+    size_t pad = (width > len) ? (width - len) : 0;
+    size_t before = 0, zeros = 0;
+    if ((align == '\0') && zero)
+      zeros = pad;
+    else if (align == '^')
+      before = pad / 2;
+    else if (align != '<')
+      before = pad;
+    size_t after = pad - before - zeros;
+    for (size_t i = 0; i < before; i++) *out++ = fill;
+    if (signChar != '\0') *out++ = signChar;
+    for (size_t i = 0; i < plen; i++) *out++ = prefix[i];
+    for (size_t i = 0; i < zeros; i++) *out++ = '0';
+    bool upper = (type == 'X');
+    for (size_t i = 0; i < ndigits; i++) {
+      if (grouped && (i > 0) && ((ndigits - i) % every == 0)) *out++ = group;
+      char c = digits[i];
+      *out++ = (upper && (c >= 'a')) ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+    for (size_t i = 0; i < after; i++) *out++ = fill;
+    return out;
+  }
+};
+
+}  // namespace csbiginteger
+
+#ifdef __cpp_lib_format
+template <>
+struct std::formatter<csbiginteger::BigInteger> {
+  csbiginteger::BigIntegerFormatSpec spec;
+
+  constexpr auto parse(std::format_parse_context& ctx) {
+    const char* first = std::to_address(ctx.begin());
+    std::from_chars_result r = spec.parse(first, std::to_address(ctx.end()));
+    if (r.ec != std::errc()) throw std::format_error("invalid BigInteger spec");
+    return ctx.begin() + (r.ptr - first);
+  }
+
+  template <class FormatContext>
+  auto format(const csbiginteger::BigInteger& big, FormatContext& ctx) const {
+    return spec.write(big, ctx.out());
+  }
+};
+#endif
+
+#ifdef FMT_VERSION
+template <>
+struct fmt::formatter<csbiginteger::BigInteger> {
+  csbiginteger::BigIntegerFormatSpec spec;
+
+  constexpr auto parse(fmt::format_parse_context& ctx)
+      -> decltype(ctx.begin()) {
+    std::from_chars_result r = spec.parse(ctx.begin(), ctx.end());
+    if (r.ec != std::errc()) throw fmt::format_error("invalid BigInteger spec");
+    return r.ptr;
+  }
+
+  template <class FormatContext>
+  auto format(const csbiginteger::BigInteger& big, FormatContext& ctx) const
+      -> decltype(ctx.out()) {
+    return spec.write(big, ctx.out());
+  }
+};
+#endif
+
+#endif  // CS_BIGINTEGER_FORMAT_HPP
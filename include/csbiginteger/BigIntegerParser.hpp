@@ -0,0 +1,215 @@
+// SPDX-License-Identifier:  MIT
+// Copyright (C) 2020-2022 - csbiginteger-cpp project
+
+#ifndef CS_BIGINTEGER_PARSER_HPP
+#define CS_BIGINTEGER_PARSER_HPP
+
+// c++
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+// internal classes
+#include <csbiginteger/BigInteger.h>
+#include <csbiginteger/Limbs.hpp>
+
+namespace csbiginteger {
+
+// Incremental parser: same input as BigInteger::Parse (optional '-', then
+// digits of any radix accepted by ToChars), given in arbitrary chunks.
+//
+// Power of two radixes append bits as they arrive. Other radixes group
+// digits in limb sized chunks, then in blocks of DEC_SPLIT chunks (horner),
+// and equal sized blocks are combined as a binary counter (high * B^n + low),
+// so total work is subquadratic and only O(value) limbs are kept.
+//
+// Example:
+//   BigIntegerParser parser;
+//   while (read(buf)) parser.feed(buf);
+//   BigInteger big = parser.finish();  // Error() on invalid input
+class BigIntegerParser final {
+ private:
+  struct Block {
+    cs_vlimb limbs;
+    size_t level;  // block has DEC_SPLIT*2^level chunks
+  };
+
+  int base;
+  int bits;           // bits per digit on power of two radixes (zero if not)
+  int width;          // digits per chunk
+  cs_limb chunkBase;  // base^width
+  bool started{false};
+  bool negative{false};
+  bool error{false};
+  size_t ndigits{0};
+  // power of two radixes
+  cs_vbyte bytes;  // complete bytes (big-endian)
+  unsigned bitbuf{0};
+  int nbits{0};
+  // other radixes
+  cs_limb partial{0};  // current chunk
+  int partialLen{0};
+  cs_vlimb leaf;  // horner over chunks (most significant first)
+  size_t leafCount{0};
+  std::vector<Block> blocks;  // decreasing levels
+  std::vector<cs_vlimb> pw;   // pw[k] = chunkBase^(DEC_SPLIT*2^k)
+
+ public:
+  explicit BigIntegerParser(int base = 10) : base(base) {
+    bits = Helper::radixBits(base);
+    chunkBase = Helper::isRadix(base) ? Limbs::radixChunk(base, width) : 0;
+    error = !Helper::isRadix(base);
+  }
+
+  // consumes all chars of 'chunk'. returns false (and stays on error) when
+  // some char is not accepted
+  bool feed(std::string_view chunk) {
+    const char* p = chunk.data();
+    const char* last = p + chunk.size();
+    if (error) return false;
+    if ((p != last) && !started) {
+      started = true;
+      negative = (base != 64) && (*p == '-');
+      if (negative) p++;
+    }
+    if (bits != 0) {
+      for (; p != last; p++) {
+        int d = Helper::digitValue(*p, base);
+        if (d >= base) return fail();
+        bitbuf = (bitbuf << bits) | d;
+        nbits += bits;
+        if (nbits >= 8) {
+          nbits -= 8;
+          bytes.push_back(static_cast<cs_byte>(bitbuf >> nbits));
+          bitbuf &= (1u << nbits) - 1;
+        }
+        ndigits++;
+      }
+      return true;
+    }
+    while (p != last) {
+      if ((base == 10) && (partialLen == 0) && (last - p >= width)) {
+        // whole chunk at once (SWAR)
+        if (Limbs::decimalRun(p, p + width) != p + width) return fail();
+        pushChunk(Limbs::decimalChunk(p, width));
+        p += width;
+        ndigits += width;
+        continue;
+      }
+      int d = Helper::digitValue(*p++, base);
+      if (d >= base) return fail();
+      partial = partial * base + d;
+      ndigits++;
+      if (++partialLen == width) {
+        pushChunk(partial);
+        partial = 0;
+        partialLen = 0;
+      }
+    }
+    return true;
+  }
+
+  // value of all chunks (Error() on invalid or empty input, or when current
+  // BigIntegerContext was cancelled). parser is reset
+  BigInteger finish() {
+    if (error || (ndigits == 0)) {
+      reset();
+      return BigInteger::Error();
+    }
+    cs_vbyte mag;
+    if (bits != 0) {
+      // shift complete bytes left by the pending bits
+      mag.resize(bytes.size() + 1);
+      unsigned carry = 0;
+      for (size_t i = 0; i < bytes.size(); i++) {
+        unsigned v = (carry << 8) | bytes[i];
+        mag[i] = static_cast<cs_byte>(v >> (8 - nbits));
+        carry = v & ((1u << (8 - nbits)) - 1);
+      }
+      mag.back() = static_cast<cs_byte>((carry << nbits) | bitbuf);
+    } else {
+      // acc = leaf * base^partialLen + partial, then blocks from the smallest
+      cs_limb scale = 1;
+      for (int i = 0; i < partialLen; i++) scale *= base;
+      cs_vlimb acc = leaf, accPow(1, 1), t;
+      Limbs::mulAdd(acc, scale, partial);
+      for (size_t i = 0; i < leafCount; i++)
+        Limbs::mulAdd(accPow, chunkBase, 0);
+      Limbs::mulAdd(accPow, scale, 0);
+      for (size_t i = blocks.size(); i-- > 0;) {
+        combine(blocks[i].limbs, accPow, acc);
+        if (i > 0) {
+          Limbs::mul(accPow, pw[blocks[i].level], t);
+          accPow.swap(t);
+        }
+      }
+      Limbs::toBytes(acc, mag);
+    }
+    if (BigIntegerContext::Cancelled()) {
+      reset();
+      return BigInteger::Error();
+    }
+    cs_vbyte data;
+    Helper::fromMagnitude(mag.data(), mag.size(), negative, data);
+    reset();
+    return BigInteger(data, false, true);
+  }
+
+  void reset() { *this = BigIntegerParser(base); }
+
+  // number of digits consumed so far
+  size_t digits() const { return ndigits; }
+
+ private:
+  bool fail() {
+    error = true;
+    return false;
+  }
+
+  void pushChunk(cs_limb chunk) {
+    Limbs::mulAdd(leaf, chunkBase, chunk);
+    if (++leafCount < Limbs::DEC_SPLIT) return;
+    blocks.push_back(Block{std::move(leaf), 0});
+    leaf.clear();
+    leafCount = 0;
+    // merge equal levels: high * pw[level] + low
+    while ((blocks.size() >= 2) &&
+           (blocks[blocks.size() - 2].level == blocks.back().level)) {
+      Block low = std::move(blocks.back());
+      blocks.pop_back();
+      Block& high = blocks.back();
+      combine(high.limbs, power(low.level), low.limbs);
+      high.limbs.swap(low.limbs);
+      high.level++;
+    }
+  }
+
+  // low = high * scale + low
+  static void combine(const cs_vlimb& high, const cs_vlimb& scale,
+                      cs_vlimb& low) {
+    if (high.empty()) return;  // leading zeroes
+    cs_vlimb t;
+    Limbs::mul(high, scale, t);
+    t.resize(std::max(t.size(), low.size()) + 1, 0);
+    Limbs::add(t.data(), t.size(), low.data(), low.size());
+    Limbs::trim(t);
+    low.swap(t);
+  }
+
+  const cs_vlimb& power(size_t level) {
+    if (pw.empty()) {
+      pw.emplace_back(1, 1);
+      for (size_t i = 0; i < Limbs::DEC_SPLIT; i++)
+        Limbs::mulAdd(pw[0], chunkBase, 0);
+    }
+    while (pw.size() <= level) {
+      pw.emplace_back();
+      Limbs::mul(pw[pw.size() - 2], pw[pw.size() - 2], pw.back());
+    }
+    return pw[level];
+  }
+};
+
+}  // namespace csbiginteger
+
+#endif  // CS_BIGINTEGER_PARSER_HPP
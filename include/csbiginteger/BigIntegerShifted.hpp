@@ -0,0 +1,216 @@
+// SPDX-License-Identifier:  MIT
+// Copyright (C) 2020-2022 - csbiginteger-cpp project
+
+#ifndef CS_BIGINTEGER_SHIFTED_HPP
+#define CS_BIGINTEGER_SHIFTED_HPP
+
+// c++
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+// internal classes
+#include <csbiginteger/BigInteger.h>
+
+namespace csbiginteger {
+
+// Lazily shifted value: mantissa * 2^exponent, with an odd mantissa (or zero,
+// with exponent 0). Shifts and products by powers of two only move the
+// exponent, comparisons and bit length work on mantissas (plus an alignment
+// bounded by their size), and the shifted value is materialized only by
+// ToBigInteger(). Sums align both operands to the smaller exponent.
+// Engine shifts take int32 counts: materializing a shift (ToBigInteger(), or
+// aligning a sum) beyond INT32_MAX bits gives Error().
+//
+// Example:
+//   BigIntegerShifted x(big);
+//   x = (x << 1000000000) * y;  // O(1) shift, mantissa product
+//   if (x > limit) ...          // no materialization
+//   BigInteger r = (x >> 999999990).ToBigInteger();
+class BigIntegerShifted final {
+ private:
+  BigInteger mantissa;  // odd, zero or Error()
+  cs_int64 exponent{0};
+
+  // moves trailing zero bits of mantissa into exponent
+  void normalize() {
+    if (mantissa.IsError() || mantissa.IsZero()) {
+      exponent = 0;
+      return;
+    }
+    cs_int64 tz = mantissa.TrailingZeroCount();
+    if (tz > 0) {
+      mantissa = mantissa >> tz;
+      exponent += tz;
+    }
+  }
+
+  // m * 2^n, floor division for n < 0 (as BigInteger shifts, int64 counts)
+  static BigInteger shift(const BigInteger& m, cs_int64 n) {
+    if (m.IsError()) return m;
+    if (n >= 0) {
+      if (n > std::numeric_limits<cs_int32>::max()) return BigInteger::Error();
+      return m << n;
+    }
+    if (n <= -m.GetBitLength())
+      return (m.Sign() < 0) ? BigInteger::MinusOne() : BigInteger::Zero();
+    return m >> -n;
+  }
+
+  static BigIntegerShifted make(BigInteger m, cs_int64 e) {
+    BigIntegerShifted r;
+    r.mantissa = std::move(m);
+    r.exponent = e;
+    r.normalize();
+    return r;
+  }
+
+ public:
+  BigIntegerShifted() : mantissa(BigInteger::Zero()) {}
+
+  // big * 2^shift
+  explicit BigIntegerShifted(BigInteger big, cs_int64 shift = 0)
+      : mantissa(std::move(big)), exponent(shift) {
+    normalize();
+  }
+
+  static BigIntegerShifted Error() {
+    return BigIntegerShifted(BigInteger::Error());
+  }
+
+  const BigInteger& Mantissa() const { return mantissa; }
+
+  cs_int64 Exponent() const { return exponent; }
+
+  bool IsError() const { return mantissa.IsError(); }
+
+  bool IsZero() const { return mantissa.IsZero(); }
+
+  cs_int32 Sign() const { return mantissa.Sign(); }
+
+  // as BigInteger::GetBitLength() of the materialized value
+  cs_int64 GetBitLength() const {
+    if (IsZero() || IsError()) return 0;
+    return mantissa.GetBitLength() + exponent;
+  }
+
+  // shifted value (the only step that touches 'exponent' bits). Error()
+  // beyond INT32_MAX bits
+  BigInteger ToBigInteger() const { return shift(mantissa, exponent); }
+
+  // ============ shifts and powers of two ============
+
+  BigIntegerShifted operator<<(cs_int64 n) const {
+    if (n < 0) return (*this) >> -n;
+    if (IsError() || IsZero()) return *this;
+    BigIntegerShifted r = *this;
+    r.exponent += n;
+    return r;
+  }
+
+  // floor division by 2^n (as BigInteger::operator>>)
+  BigIntegerShifted operator>>(cs_int64 n) const {
+    if (n < 0) return (*this) << -n;
+    if (IsError() || IsZero()) return *this;
+    if (n <= exponent) {
+      BigIntegerShifted r = *this;
+      r.exponent -= n;
+      return r;
+    }
+    return make(shift(mantissa, exponent - n), 0);
+  }
+
+  // ================ arithmetic ===================
+
+  BigIntegerShifted operator-() const {
+    BigIntegerShifted r = *this;
+    if (!IsError()) r.mantissa = -mantissa;
+    return r;
+  }
+
+  // product of odd mantissas is odd (no normalization)
+  BigIntegerShifted operator*(const BigIntegerShifted& other) const {
+    if (IsError() || other.IsError()) return Error();
+    if (IsZero() || other.IsZero()) return BigIntegerShifted();
+    BigIntegerShifted r;
+    r.mantissa = mantissa * other.mantissa;
+    r.exponent = exponent + other.exponent;
+    return r;
+  }
+
+  BigIntegerShifted operator*(const BigInteger& big) const {
+    return (*this) * BigIntegerShifted(big);
+  }
+
+  BigIntegerShifted operator+(const BigIntegerShifted& other) const {
+    return add(other, false);
+  }
+
+  BigIntegerShifted operator-(const BigIntegerShifted& other) const {
+    return add(other, true);
+  }
+
+  // ================ comparison ===================
+
+  // -1, 0 or 1 (Error() compares below everything, as equal to itself)
+  static int Compare(const BigIntegerShifted& a, const BigIntegerShifted& b) {
+    if (a.IsError() || b.IsError()) return b.IsError() - a.IsError();
+    int sa = a.Sign(), sb = b.Sign();
+    if ((sa != sb) || (sa == 0)) return (sa > sb) - (sa < sb);
+    // same sign: more bits is further from zero
+    cs_int64 la = a.GetBitLength(), lb = b.GetBitLength();
+    if (la != lb) return ((la > lb) ? 1 : -1) * sa;
+    // same length: align larger exponent down (shift below mantissa length)
+    const BigInteger& ma = a.mantissa;
+    const BigInteger& mb = b.mantissa;
+    cs_int64 d = a.exponent - b.exponent;
+    return (d > 0) ? cmp(ma << d, mb) : cmp(ma, mb << -d);
+  }
+
+  bool operator==(const BigIntegerShifted& other) const {
+    // canonical form
+    return (exponent == other.exponent) && (mantissa == other.mantissa);
+  }
+
+  bool operator!=(const BigIntegerShifted& other) const {
+    return !((*this) == other);
+  }
+
+  bool operator<(const BigIntegerShifted& other) const {
+    return Compare(*this, other) < 0;
+  }
+
+  bool operator>(const BigIntegerShifted& other) const {
+    return Compare(*this, other) > 0;
+  }
+
+  bool operator<=(const BigIntegerShifted& other) const {
+    return Compare(*this, other) <= 0;
+  }
+
+  bool operator>=(const BigIntegerShifted& other) const {
+    return Compare(*this, other) >= 0;
+  }
+
+ private:
+  static int cmp(const BigInteger& a, const BigInteger& b) {
+    return (a > b) - (a < b);
+  }
+
+  // aligned to the smaller exponent (Error() when exponents differ by more
+  // than INT32_MAX)
+  BigIntegerShifted add(const BigIntegerShifted& other, bool negate) const {
+    if (IsError() || other.IsError()) return Error();
+    if (other.IsZero()) return *this;
+    if (IsZero()) return negate ? -other : other;
+    cs_int64 e = std::min(exponent, other.exponent);
+    BigInteger a = shift(mantissa, exponent - e);
+    BigInteger b = shift(other.mantissa, other.exponent - e);
+    if (a.IsError() || b.IsError()) return Error();
+    return make(negate ? a - b : a + b, e);
+  }
+};
+
+}  // namespace csbiginteger
+
+#endif  // CS_BIGINTEGER_SHIFTED_HPP
@@ -0,0 +1,147 @@
+// SPDX-License-Identifier:  MIT
+// Copyright (C) 2020-2022 - csbiginteger-cpp project
+
+#ifndef CS_BIGINTEGER_STRING_CACHE_HPP
+#define CS_BIGINTEGER_STRING_CACHE_HPP
+
+// c++
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+// internal classes
+#include <csbiginteger/types.h>
+
+namespace csbiginteger {
+
+// process-wide LRU of ToString results for large values, disabled until a
+// budget is set. entries are keyed by value bytes (and base), so a mutated
+// value never finds a stale string: its old entry is just evicted later.
+// only superlinear conversions are kept (bases that are not powers of two,
+// such as 10); hex and binary strings are a linear pass over bytes.
+// all methods may be called from any thread
+class BigIntegerStringCache {
+ public:
+  // values smaller than this (in bytes) are converted directly
+  static constexpr size_t MIN_BYTES = 64;
+
+  // bookkeeping cost of an entry (list node, map node), beyond its strings
+  static constexpr size_t ENTRY_BYTES = 128;
+
+  struct Stats {
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+    size_t entries;
+    size_t bytes;  // charged to budget
+  };
+
+  // maximum bytes kept (0 disables and drops all entries, the default)
+  static void SetBudget(size_t bytes) {
+    Cache& c = cache();
+    std::lock_guard<std::mutex> guard(c.lock);
+    c.budget.store(bytes, std::memory_order_relaxed);
+    evict(c);
+  }
+
+  static size_t Budget() {
+    return cache().budget.load(std::memory_order_relaxed);
+  }
+
+  static Stats GetStats() {
+    Cache& c = cache();
+    std::lock_guard<std::mutex> guard(c.lock);
+    return Stats{c.hits, c.misses, c.evictions, c.lru.size(), c.bytes};
+  }
+
+  // drops all entries and zeroes stats (budget is kept)
+  static void Clear() {
+    Cache& c = cache();
+    std::lock_guard<std::mutex> guard(c.lock);
+    c.index.clear();
+    c.lru.clear();
+    c.bytes = c.hits = c.misses = c.evictions = 0;
+  }
+
+  // cached string of value (big-endian bytes) in 'base', false on miss
+  static bool Find(const cs_byte* data, size_t n, int base, std::string& out) {
+    Cache& c = cache();
+    if (c.budget.load(std::memory_order_relaxed) == 0) return false;
+    std::string k = key(data, n, base);
+    std::lock_guard<std::mutex> guard(c.lock);
+    auto it = c.index.find(k);
+    if (it == c.index.end()) {
+      c.misses++;
+      return false;
+    }
+    c.hits++;
+    c.lru.splice(c.lru.begin(), c.lru, it->second);  // most recent
+    out = it->second->second;
+    return true;
+  }
+
+  // keeps 's' as string of value in 'base' (ignored when over budget)
+  static void Insert(const cs_byte* data, size_t n, int base,
+                     const std::string& s) {
+    Cache& c = cache();
+    size_t budget = c.budget.load(std::memory_order_relaxed);
+    if (charge(n, s.size()) > budget) return;  // also when disabled
+    std::string k = key(data, n, base);
+    std::lock_guard<std::mutex> guard(c.lock);
+    if (c.index.count(k) != 0) return;  // raced with another thread
+    c.lru.emplace_front(k, s);
+    c.index.emplace(std::move(k), c.lru.begin());
+    c.bytes += charge(n, s.size());
+    evict(c);
+  }
+
+ private:
+  using Entry = std::pair<std::string, std::string>;  // key, string
+
+  struct Cache {
+    std::atomic<size_t> budget{0};
+    std::mutex lock;       // everything below
+    std::list<Entry> lru;  // most recent first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    size_t bytes{0};
+    size_t hits{0};
+    size_t misses{0};
+    size_t evictions{0};
+  };
+
+  static Cache& cache() {
+    static Cache c;
+    return c;
+  }
+
+  static std::string key(const cs_byte* data, size_t n, int base) {
+    std::string k(reinterpret_cast<const char*>(data), n);
+    k.push_back(static_cast<char>(base));
+    return k;
+  }
+
+  // bytes charged to budget (key is value plus base)
+  static size_t charge(size_t n, size_t chars) {
+    return 2 * (n + 1) + chars + ENTRY_BYTES;
+  }
+
+  // drops least recent entries (lock held)
+  static void evict(Cache& c) {
+    size_t budget = c.budget.load(std::memory_order_relaxed);
+    while ((c.bytes > budget) && !c.lru.empty()) {
+      const Entry& e = c.lru.back();
+      c.bytes -= charge(e.first.size() - 1, e.second.size());
+      c.index.erase(e.first);
+      c.lru.pop_back();
+      c.evictions++;
+    }
+  }
+};
+
+}  // namespace csbiginteger
+
+#endif  // CS_BIGINTEGER_STRING_CACHE_HPP
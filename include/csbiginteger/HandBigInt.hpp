@@ -8,6 +8,7 @@
 #include <assert.h>
 //
 #include <algorithm>
+#include <cstdint>
 #include <iomanip>  // setfill
 #include <string>
 #include <vector>
@@ -75,6 +76,31 @@ class HandHelper {
   }
 };
 
+// per-thread working strings of HandBigInt arithmetic (remainders, products,
+// powers), by size class in digits, so steady-state operations reuse their
+// capacity instead of building temporaries
+class HandScratch {
+ public:
+  static const int NUM_CLASSES = 3;
+  static const int NUM_SLOTS = 3;  // pow keeps result, square and product
+
+  static int sizeClass(size_t digits) {
+    return digits <= 40 ? 0 : (digits <= 1200 ? 1 : 2);
+  }
+
+  // empty working string 'i' for operands of about 'digits'
+  static std::string& get(size_t digits, int i = 0) {
+    static thread_local std::string slots[NUM_CLASSES][NUM_SLOTS];
+    int c = sizeClass(digits);
+    std::string& s = slots[c][i];
+    // large slots give back memory above 16x the requested size
+    if ((c == NUM_CLASSES - 1) && (s.capacity() > 16 * digits))
+      std::string().swap(s);
+    s.clear();
+    return s;
+  }
+};
+
 class HandBigInt {
  public:
   // the internals of HandBigInt are meant to be simple
@@ -117,11 +143,8 @@ class HandBigInt {
 
     // build number byte by byte
     HandBigInt big(0);
-    for (unsigned i = 0; i < vb.size(); i++) {
-      // std::cout << big.toString();
-      big = big * 256 + vb[i];
-      // std::cout << "*256 + " << (int)vb[i] << " = " << big << std::endl;
-    }
+    for (unsigned i = 0; i < vb.size(); i++)
+      mulSmall(big.sdec, 256, vb[i]);  // in place
 
     // std::cout << "=====> fromUnsignedHex FINAL 16  in decimal = " <<
     // big.toString() << std::endl;
@@ -144,9 +167,8 @@ class HandBigInt {
 
     // build number bit by bit
     HandBigInt big(0);
-    for (unsigned i = 0; i < str.length(); i++) {
-      big = big * 2 + (str[i] - '0');
-    }
+    for (unsigned i = 0; i < str.length(); i++)
+      mulSmall(big.sdec, 2, str[i] - '0');  // in place
 
     // std::cout << "=====> FINAL 2  in decimal = " << big.toString() <<
     // std::endl;
@@ -238,10 +260,28 @@ class HandBigInt {
 
   // ================
 
+  // square-and-multiply over working strings (no temporaries per step)
   static HandBigInt pow(HandBigInt base, unsigned int exp) {
-    HandBigInt num = 1;
-    for (int i = 0; i < exp; i++) num = num * base;
-    return num;
+    size_t digits = base.sdec.size() * std::max(exp, 1u);
+    std::string& num = HandScratch::get(digits, 0);
+    std::string& sq = HandScratch::get(digits, 1);
+    std::string& t = HandScratch::get(digits, 2);
+    num = "1";
+    sq = base.sdec;
+    for (unsigned int e = exp; e > 0; e >>= 1) {
+      if (e & 1) {
+        mulDigits(num, sq, t);
+        num.swap(t);
+      }
+      if (e > 1) {
+        mulDigits(sq, sq, t);
+        sq.swap(t);
+      }
+    }
+    HandBigInt r;
+    r.sdec = num;
+    r.fix((exp & 1) ? base.sign : 1);
+    return r;
   }
 
   // get as string in specific base
@@ -256,25 +296,22 @@ class HandBigInt {
       // re-use toString() implementation
       return toString();
     } else if (base == 16) {
-      std::string shex;
-      HandBigInt copy = *this;
+      std::string& copy = HandScratch::get(sdec.size());
+      copy = sdec;
       cs_vbyte bytes;
-      while (copy > 0) {
-        int byteDigit = (copy % 256).get_ui();
-        bytes.insert(bytes.begin(), byteDigit);
-        copy = copy / 256;
-      }
+      // positive only (as before), least significant byte first
+      while ((sign == 1) && !((copy.size() == 1) && (copy[0] == '0')))
+        bytes.push_back(static_cast<cs_byte>(divSmall(copy, 256)));
+      std::reverse(bytes.begin(), bytes.end());
       return HandHelper::toHexString(bytes);
     } else {
       // std::cerr << "get_str BASE " << base << std::endl;
       std::string sbin;
-      HandBigInt copy = *this;
-      while (copy > 0) {
-        HandBigInt binDigit = copy % 2;
-        // sbin += binDigit.toString()[0];
-        sbin.insert(sbin.begin(), binDigit.toString()[0]);
-        copy = copy / 2;
-      }
+      std::string& copy = HandScratch::get(sdec.size());
+      copy = sdec;
+      while ((sign == 1) && !((copy.size() == 1) && (copy[0] == '0')))
+        sbin += static_cast<char>('0' + divSmall(copy, 2));
+      std::reverse(sbin.begin(), sbin.end());
       // give in multiple of 8's (don't know why exactly...)
       // while(sbin.length()%8 != 0)
       //   sbin.insert(sbin.begin(), '0');
@@ -306,162 +343,48 @@ class HandBigInt {
   }
 
   HandBigInt operator+(const HandBigInt& other) {
-    // std::cout << "operator+(me=" << *this << " other=" << other << ")" <<
-    // std::endl;
-    //  perform copy of myself (TODO(igormcoelho): do we really need this?)
-    HandBigInt copy = *this;
-
-    // if signs are different, it's subtraction: we need to call operator-
-    if (copy.sign != other.sign) {
-      HandBigInt other2 = other;  // copy to invert
-      return copy - other2.neg();
-    }
-
-    // result to return
-    HandBigInt r;
-
-    int c = 0;  // value to carry
-    for (int i = 0; i < std::max(sdec.size(), other.sdec.size()) || c > 0;
-         i++) {
-      // add on 'c' from 'copy' and 'other'
-      if (i < copy.sdec.size()) c += copy.sdec[i] - '0';
-      if (i < other.sdec.size()) c += other.sdec[i] - '0';
-
-      // put carry on result 'r'
-      r.sdec += (c % 10 + '0');
-      // leave rest on 'c' to carry next
-      c /= 10;
-    }
-
-    return r.fix(this->sign);
+    return addSigned(*this, other, other.sign);
   }
 
   HandBigInt operator-(const HandBigInt& other) const {
-    // std::cout << "operator-(me=" << *this << " other=" << other << ")" <<
-    // std::endl;
-    HandBigInt copy = *this;
-
-    HandBigInt other2 = other;
-    // if sign is different, operation is addition
-    if (copy.sign != other2.sign) {
-      return copy + other2.neg();
-    }
-
-    // store old sign
-    int _sign = copy.sign;
-    // set all positive
-    copy.sign = other2.sign = 1;
-    // TODO(igormcoelho): assume other is positive
-    // copy.sign = 1;
-
-    // invoke operator<
-    if (copy < other2) return ((other2 - copy).neg()).fix(-_sign);
-
-    // std::cout << "operator- general computation copy.sdec='" << sdec << "'
-    // other2.sdec='" << other2.sdec << "'" << std::endl;
-    //  first operand must be greater than second
-    HandBigInt r;
-    //
-    int b = 0;  // for borrow operations
-    for (unsigned i = 0; i < sdec.size(); i++) {
-      b += (copy.sdec[i] - '0');
-
-      if (i < other2.sdec.size()) b -= other2.sdec[i] - '0';
-
-      // add char into sdec sequence
-      if (b >= 0)
-        r.sdec += b + '0';
-      else
-        r.sdec += b + '0' + 10;
-
-      b = (b >= 0 ? 0 : -1);
-    }
-
-    // std::cout << "operator- general computation = " << *this << std::endl;
-    return r.fix(_sign);
+    return addSigned(*this, other, -other.sign);
   }
 
   HandBigInt operator*(const HandBigInt& other) const {
-    HandBigInt r("0");
-    HandBigInt other2 = other;
-
-    for (int i = 0; i < sdec.size(); i++) {
-      int v = sdec[i] - '0';
-      while (v--) {
-        // apply several additions
-        r = r + other2;
-      }
-
-      other2.sdec.insert(other2.sdec.begin(), '0');
-    }
-
-    return r.fix(this->sign * other2.sign);
+    std::string& acc = HandScratch::get(sdec.size() + other.sdec.size());
+    mulDigits(sdec, other.sdec, acc);
+    HandBigInt r;
+    r.sdec = acc;
+    r.fix(this->sign * other.sign);
+    return r;
   }
 
   HandBigInt operator/(const HandBigInt& other) const {
-    // std::cout << "operator/(" << *this << " , " << other << ")" << std::endl;
-
-    HandBigInt other2 = other;
-
-    if (other2.isZero()) {
-      // other2.sdec[0] /= (other2.sdec[0] - '0');
+    if (other.isZero()) {
       //  std::cerr << "DIVISION BY ZERO! TODO(igormcoelho): use 'error' flag"
       //  << std::endl;
       assert(false);
     }
-
     HandBigInt r;
-
-    // fill result with zeroes
-    for (unsigned i = 0; i < sdec.size(); i++) r.sdec += "0";
-
-    // get final sign
-    int _sign = this->sign * other2.sign;
-
-    // make positive
-    other2.sign = 1;
-
-    HandBigInt aux{0};  // AUX is zero!
-    for (int i = ((int)sdec.size()) - 1; i >= 0; i--) {
-      aux = aux * 10;
-      HandBigInt num(sdec.substr(i, 1));
-      // aux = aux + sdec.substr(i, 1);
-      aux = aux + num;
-      // std::cout << "aux = '" << aux.sdec << "'" << std::endl;
-      //  repeated subtractions
-      while (!(aux < other2)) {
-        aux = aux - other2;
-        r.sdec[i]++;
-      }
-    }
-
-    return r.fix(_sign);
+    r.sdec.assign(sdec.size(), '0');
+    std::string& rem = HandScratch::get(other.sdec.size() + 1);
+    divDigits(sdec, other.sdec, &r.sdec, rem);
+    r.fix(this->sign * other.sign);
+    return r;
   }
 
   HandBigInt operator%(const HandBigInt& other) const {
-    // std::cout << "operator%(" << *this << " , " << other << ")" << std::endl;
-
-    HandBigInt other2 = other;
-
-    if (other2.isZero()) {
+    if (other.isZero()) {
       // std::cerr << "DIVISION (MOD) BY ZERO! TODO(igormcoelho): use 'error'
       // flag" << std::endl;
       assert(false);
     }
-
-    HandBigInt r{0};
-
-    other2.sign = 1;
-
-    for (int i = ((int)sdec.size()) - 1; i >= 0; i--) {
-      r = r * 10;
-      HandBigInt num(sdec.substr(i, 1));
-      r = r + num;
-      // repeated subtractions
-      while (!(r < other2)) r = r - other2;
-    }
-
-    return r.fix(this->sign);
+    std::string& rem = HandScratch::get(other.sdec.size() + 1);
+    divDigits(sdec, other.sdec, nullptr, rem);
+    HandBigInt r;
+    r.sdec = rem;
+    r.fix(this->sign);
+    return r;
   }
 
   friend std::ostream& operator<<(std::ostream& os, const HandBigInt& me) {
@@ -527,20 +450,151 @@ class HandBigInt {
 
   // =====================
 
-  // shift left (multiply by two)
+  // shift left (multiply by two), in place by up to 2^24 per pass
   HandBigInt operator<<(int32_t big) {
     if (big < 0) return this->operator>>(-big);
-    //
-    for (int i = 0; i < big; i++) (*this) = (*this) * 2;
-    return *this;
+    for (; big > 0; big -= std::min(big, 24))
+      mulSmall(sdec, 1 << std::min(big, 24), 0);
+    return fix(sign);
   }
 
-  // shift right (divide by two)
+  // shift right (floor division by two, as C#), in place by up to 2^24 per
+  // pass
   HandBigInt operator>>(int32_t big) {
     if (big < 0) return this->operator<<(-big);
-    //
-    for (int i = 0; i < big; i++) (*this) = (*this) / 2;
-    return *this;
+    bool inexact = false;
+    for (; big > 0; big -= std::min(big, 24))
+      inexact |= (divSmall(sdec, 1 << std::min(big, 24)) != 0);
+    if (inexact && (sign < 0)) mulSmall(sdec, 1, 1);  // towards -infinity
+    return fix(sign);
+  }
+
+  // =====================
+  // magnitude kernels: reversed decimal digits, in place, no temporaries
+
+  // -1, 0 or 1 (no extra zeroes)
+  static int cmpDigits(const std::string& a, const std::string& b) {
+    if (a.size() != b.size()) return a.size() < b.size() ? -1 : 1;
+    for (size_t i = a.size(); i-- > 0;)
+      if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+    return 0;
+  }
+
+  // erases extra zeroes (empty is zero)
+  static void trimDigits(std::string& a) {
+    size_t n = a.size();
+    while ((n > 1) && (a[n - 1] == '0')) n--;
+    a.resize(n);
+    if (a.empty()) a = "0";
+  }
+
+  // a += b
+  static void addDigits(std::string& a, const std::string& b) {
+    if (a.size() < b.size()) a.resize(b.size(), '0');
+    int c = 0;  // carry
+    for (size_t i = 0; (i < a.size()) && ((i < b.size()) || (c > 0)); i++) {
+      c += (a[i] - '0') + (i < b.size() ? b[i] - '0' : 0);
+      a[i] = static_cast<char>('0' + c % 10);
+      c /= 10;
+    }
+    if (c > 0) a += static_cast<char>('0' + c);
+  }
+
+  // a -= b (requires a >= b)
+  static void subDigits(std::string& a, const std::string& b) {
+    int borrow = 0;
+    for (size_t i = 0; (i < a.size()) && ((i < b.size()) || borrow); i++) {
+      int v = (a[i] - '0') - borrow - (i < b.size() ? b[i] - '0' : 0);
+      borrow = (v < 0);
+      a[i] = static_cast<char>('0' + v + 10 * borrow);
+    }
+    trimDigits(a);
+  }
+
+  // out = a * b (out must not alias a or b)
+  static void mulDigits(const std::string& a, const std::string& b,
+                        std::string& out) {
+    out.assign(a.size() + b.size(), '0');
+    for (size_t i = 0; i < a.size(); i++) {
+      int c = 0;  // carry
+      int ai = a[i] - '0';
+      for (size_t j = 0; j < b.size(); j++) {
+        c += (out[i + j] - '0') + ai * (b[j] - '0');
+        out[i + j] = static_cast<char>('0' + c % 10);
+        c /= 10;
+      }
+      for (size_t k = i + b.size(); c > 0; k++) {
+        c += out[k] - '0';
+        out[k] = static_cast<char>('0' + c % 10);
+        c /= 10;
+      }
+    }
+    trimDigits(out);
+  }
+
+  // a = a * m + add (m < 2^25, add < m)
+  static void mulSmall(std::string& a, int m, int add) {
+    int64_t c = add;
+    for (char& d : a) {
+      c += static_cast<int64_t>(d - '0') * m;
+      d = static_cast<char>('0' + c % 10);
+      c /= 10;
+    }
+    for (; c > 0; c /= 10) a += static_cast<char>('0' + c % 10);
+    trimDigits(a);
+  }
+
+  // a = a / m (m < 2^25), returns remainder
+  static int divSmall(std::string& a, int m) {
+    int64_t r = 0;
+    for (size_t i = a.size(); i-- > 0;) {
+      r = r * 10 + (a[i] - '0');
+      a[i] = static_cast<char>('0' + r / m);
+      r %= m;
+    }
+    trimDigits(a);
+    return static_cast<int>(r);
+  }
+
+  // long division by repeated subtraction: 'q' (same size as a, when given)
+  // gets quotient digits and 'rem' the remainder
+  static void divDigits(const std::string& a, const std::string& b,
+                        std::string* q, std::string& rem) {
+    rem = "0";
+    for (size_t i = a.size(); i-- > 0;) {
+      // rem = rem * 10 + a[i]
+      if ((rem.size() == 1) && (rem[0] == '0'))
+        rem[0] = a[i];
+      else
+        rem.insert(rem.begin(), a[i]);
+      char digit = '0';
+      while (cmpDigits(rem, b) >= 0) {
+        subDigits(rem, b);
+        digit++;
+      }
+      if (q != nullptr) (*q)[i] = digit;
+    }
+  }
+
+  // a + b * (bsign), shared by operator+ and operator-
+  static HandBigInt addSigned(const HandBigInt& a, const HandBigInt& b,
+                              int bsign) {
+    HandBigInt r;
+    r.sdec.reserve(std::max(a.sdec.size(), b.sdec.size()) + 1);
+    if (a.sign == bsign) {
+      r.sdec = a.sdec;
+      addDigits(r.sdec, b.sdec);
+      r.fix(a.sign);
+    } else if (cmpDigits(a.sdec, b.sdec) >= 0) {
+      r.sdec = a.sdec;
+      subDigits(r.sdec, b.sdec);
+      r.fix(a.sign);
+    } else {
+      r.sdec = b.sdec;
+      subDigits(r.sdec, a.sdec);
+      r.fix(bsign);
+    }
+    return r;
   }
 };
 
@@ -18,6 +18,7 @@
 // c++
 #include <algorithm>
 #include <iomanip>  // setw
+#include <memory_resource>
 #include <string>
 #include <vector>
 
@@ -35,6 +36,8 @@ namespace csbiginteger {
 
 // c++ types
 using cs_vbyte = std::vector<csbiginteger::cs_byte>;
+// allocator-aware version (used as BigInteger storage)
+using cs_pmr_vbyte = std::pmr::vector<csbiginteger::cs_byte>;
 
 class Helper {
  public:
@@ -119,6 +122,139 @@ class Helper {
     return bytes;
   }
 
+  // two's complement big-endian bytes to magnitude big-endian bytes (same
+  // size, may keep leading zeroes). returns 'true' if number is negative.
+  // 'mag' is any byte container (reused by engines as scratch buffer)
+  template <class VByte>
+  static bool toMagnitude(const cs_byte* data, size_t n, VByte& mag) {
+    mag.assign(data, data + n);
+    bool negative = (n > 0) && (data[0] & 0x80);
+    if (negative) {
+      // two's complement: invert bits and add one
+      int carry = 1;
+      for (size_t i = n; i-- > 0;) {
+        int v = static_cast<cs_byte>(~mag[i]) + carry;
+        mag[i] = static_cast<cs_byte>(v);
+        carry = v >> 8;
+      }
+    }
+    return negative;
+  }
+
+  // magnitude big-endian bytes (leading zeroes allowed) to two's complement
+  // big-endian bytes, in its most compressed format (zero is '00')
+  template <class VByte>
+  static void fromMagnitude(const cs_byte* mag, size_t n, bool negative,
+                            VByte& data) {
+    size_t first = 0;
+    while ((first < n) && (mag[first] == 0)) first++;
+    size_t len = n - first;
+    if (len == 0) {
+      data.assign(1, 0x00);
+      return;
+    }
+    bool pad;
+    if (!negative) {
+      // positive must keep most significant bit unset
+      pad = (mag[first] & 0x80) != 0;
+    } else {
+      // -m fits 'len' bytes only when m <= 2^(8*len-1)
+      pad = mag[first] > 0x80;
+      for (size_t i = first + 1; !pad && (mag[first] == 0x80) && (i < n); i++)
+        pad = (mag[i] != 0);
+    }
+    data.resize(len + pad);
+    if (pad) data[0] = 0x00;
+    std::copy(mag + first, mag + n, data.begin() + pad);
+    if (negative) {
+      int carry = 1;
+      for (size_t i = data.size(); i-- > 0;) {
+        int v = static_cast<cs_byte>(~data[i]) + carry;
+        data[i] = static_cast<cs_byte>(v);
+        carry = v >> 8;
+      }
+    }
+  }
+
+  // remove redundant sign bytes from two's complement big-endian bytes
+  // (most compressed format, as expected by BigInteger)
+  template <class VByte>
+  static void compress(VByte& data) {
+    size_t first = 0;
+    while ((first + 1 < data.size()) &&
+           (((data[first] == 0x00) && !(data[first + 1] & 0x80)) ||
+            ((data[first] == 0xff) && (data[first + 1] & 0x80))))
+      first++;
+    if (first > 0) data.erase(data.begin(), data.begin() + first);
+  }
+
+  // value of digit char (base up to 36, any case). 36 when not a digit
+  static int digitValue(char c) {
+    if ((c >= '0') && (c <= '9')) return c - '0';
+    if ((c >= 'a') && (c <= 'z')) return c - 'a' + 10;
+    if ((c >= 'A') && (c <= 'Z')) return c - 'A' + 10;
+    return 36;
+  }
+
+  // digit char of value 'd' (lowercase, d < 36)
+  static char digitChar(int d) {
+    return "0123456789abcdefghijklmnopqrstuvwxyz"[d];
+  }
+
+  // alphabets of radixes beyond 36
+  static constexpr const char* BASE58 =
+      "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";  // bitcoin
+  static constexpr const char* BASE64URL =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+  // supported radixes: 2..36 (0-9a-z, any case), 58 and 64 (base64url)
+  static bool isRadix(int base) {
+    return ((base >= 2) && (base <= 36)) || (base == 58) || (base == 64);
+  }
+
+  // bits per digit on power of two radixes, zero otherwise
+  static int radixBits(int base) {
+    int bits = 0;
+    while ((1 << bits) < base) bits++;
+    return ((1 << bits) == base) ? bits : 0;
+  }
+
+  // value of digit char on given radix. 'base' (or more) when not a digit
+  static int digitValue(char c, int base) {
+    if (base <= 36) return digitValue(c);
+    static const std::vector<cs_byte> t58 = radixTable(BASE58);
+    static const std::vector<cs_byte> t64 = radixTable(BASE64URL);
+    return ((base == 58) ? t58 : t64)[static_cast<cs_byte>(c)];
+  }
+
+  // digit char of value 'd' on given radix
+  static char digitChar(int d, int base) {
+    if (base == 58) return BASE58[d];
+    if (base == 64) return BASE64URL[d];
+    return digitChar(d);
+  }
+
+  // char to digit value on given alphabet (255 when not a digit)
+  static std::vector<cs_byte> radixTable(const char* alphabet) {
+    std::vector<cs_byte> t(256, 255);
+    for (int i = 0; alphabet[i] != '\0'; i++)
+      t[static_cast<cs_byte>(alphabet[i])] = static_cast<cs_byte>(i);
+    return t;
+  }
+
+  // all primes p <= n (sieve of Eratosthenes)
+  static std::vector<cs_int32> primesUpTo(cs_int32 n) {
+    std::vector<cs_int32> primes;
+    if (n < 2) return primes;
+    std::vector<bool> composite(n + 1, false);
+    for (cs_int64 i = 2; i <= n; i++) {
+      if (composite[i]) continue;
+      primes.push_back(static_cast<cs_int32>(i));
+      for (cs_int64 j = i * i; j <= n; j += i) composite[j] = true;
+    }
+    return primes;
+  }
+
   // binary format to bytes (must be 8-bit padded)
   static cs_vbyte BinToBytes(const std::string& sbin) {
     cs_vbyte bytes(sbin.length() / 8);
@@ -0,0 +1,662 @@
+// SPDX-License-Identifier:  MIT
+// Copyright (C) 2020-2022 - csbiginteger-cpp project
+
+#ifndef CS_BIGINTEGER_LIMBS_HPP
+#define CS_BIGINTEGER_LIMBS_HPP
+
+// c++
+#include <algorithm>
+#include <atomic>
+#include <cstring>  // memcpy
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// internal classes
+#include <csbiginteger/BigIntegerContext.hpp>
+#include <csbiginteger/Helper.hpp>
+
+// Engine independent kernel over magnitudes stored as little-endian limbs
+// (machine words). Used by conversions that must not depend on the engine
+// (or allocate on each call). Limbs are 64-bit when the compiler offers a
+// 128-bit type, 32-bit otherwise.
+// Decimal digits are validated and converted 8 at a time (SWAR) on
+// little-endian targets. Powers of radix chunks (and their reciprocals) are
+// cached process-wide, so both conversion directions split by halves.
+// Large multiplications and conversions poll the BigIntegerContext of the
+// calling thread (results are garbage once cancelled: callers check it).
+
+namespace csbiginteger {
+
+#ifdef __SIZEOF_INT128__
+using cs_limb = cs_uint64;
+__extension__ typedef unsigned __int128 cs_dlimb;  // double limb
+__extension__ typedef __int128 cs_int128;
+#else
+using cs_limb = cs_uint32;
+using cs_dlimb = cs_uint64;  // double limb
+#endif
+
+using cs_vlimb = std::vector<cs_limb>;
+
+class Limbs {
+ public:
+  static constexpr int BITS = 8 * sizeof(cs_limb);
+
+  // schoolbook multiplication below this size (in limbs)
+  static constexpr size_t KARATSUBA = 32;
+
+  // multiplications from this size (in limbs) poll for cancellation
+  static constexpr size_t POLL_LIMBS = 256;
+
+  // horner conversion of decimal chunks below this size (in chunks)
+  static constexpr size_t DEC_SPLIT = 48;
+
+  // largest power of ten that fits a limb: 10^DEC_DIGITS
+  static constexpr int DEC_DIGITS = (BITS == 64) ? 19 : 9;
+  static constexpr cs_limb DEC_BASE =
+      (BITS == 64) ? static_cast<cs_limb>(10000000000000000000ull) : 1000000000u;
+
+  // thread-local buffers, reused by conversions of the calling thread
+  struct Scratch {
+    cs_vlimb limbs;
+    cs_vlimb chunks;
+    cs_vbyte bytes;
+  };
+
+  static Scratch& scratch() {
+    static thread_local Scratch s;
+    return s;
+  }
+
+  // powers above this size (in limbs) are not kept by cached()
+  static constexpr size_t CACHE_LIMBS = size_t{1} << 15;
+
+  // chunkBase^(2^k) of radix 'base' (see radixChunk), shared by all threads.
+  // levels are computed once (under a lock) and published with a release
+  // store, so readers never lock and entries are never replaced (RCU-style,
+  // reclaimed at exit). nullptr when level exceeds CACHE_LIMBS
+  static const cs_vlimb* cached(int base, size_t k) {
+    PowerCache& c = powerCache(base);
+    if (k >= c.limit.load(std::memory_order_acquire)) return nullptr;
+    const cs_vlimb* p = c.level[k].load(std::memory_order_acquire);
+    if (p != nullptr) return p;
+    std::lock_guard<std::mutex> guard(c.lock);
+    BigIntegerContext::Scope shared(nullptr);  // never cancelled
+    for (size_t i = 0; i <= k; i++) {
+      if (c.level[i].load(std::memory_order_relaxed) != nullptr) continue;
+      auto v = std::make_unique<cs_vlimb>();
+      if (i == 0) {
+        int width;
+        v->push_back(radixChunk(base, width));
+      } else {
+        const cs_vlimb& prev = *c.level[i - 1].load(std::memory_order_relaxed);
+        mul(prev, prev, *v);
+      }
+      if (v->size() > CACHE_LIMBS) {
+        c.limit.store(i, std::memory_order_release);
+        return nullptr;
+      }
+      c.level[i].store(v.get(), std::memory_order_release);
+      c.owned.push_back(std::move(v));
+    }
+    return c.level[k].load(std::memory_order_relaxed);
+  }
+
+  // pw[j] = chunkBase^(2^j) for j < n: cached levels are shared, larger ones
+  // are computed into 'own'
+  static void powers(int base, size_t n, std::vector<const cs_vlimb*>& pw,
+                     std::vector<cs_vlimb>& own) {
+    pw.assign(n, nullptr);
+    own.resize(n);  // stable addresses
+    for (size_t j = 0; j < n; j++) {
+      pw[j] = cached(base, j);
+      if (pw[j] != nullptr) continue;
+      mul(*pw[j - 1], *pw[j - 1], own[j]);
+      pw[j] = &own[j];
+    }
+  }
+
+  // reciprocal(*pw[j]) for j < pw.size(), shared as cached() when pw[j] is
+  // a cached level, computed into 'own' otherwise
+  static void reciprocals(int base, const std::vector<const cs_vlimb*>& pw,
+                          std::vector<const cs_vlimb*>& inv,
+                          std::vector<cs_vlimb>& own) {
+    inv.assign(pw.size(), nullptr);
+    own.resize(pw.size());  // stable addresses
+    for (size_t j = 0; j < pw.size(); j++) {
+      if (pw[j] == cached(base, j)) {
+        PowerCache& c = powerCache(base);
+        inv[j] = c.inverse[j].load(std::memory_order_acquire);
+        if (inv[j] != nullptr) continue;
+        std::lock_guard<std::mutex> guard(c.lock);
+        BigIntegerContext::Scope shared(nullptr);  // never cancelled
+        inv[j] = c.inverse[j].load(std::memory_order_relaxed);
+        if (inv[j] != nullptr) continue;
+        auto v = std::make_unique<cs_vlimb>();
+        reciprocal(*pw[j], *v);
+        inv[j] = v.get();
+        c.inverse[j].store(v.get(), std::memory_order_release);
+        c.owned.push_back(std::move(v));
+      } else {
+        reciprocal(*pw[j], own[j]);
+        inv[j] = &own[j];
+      }
+    }
+  }
+
+  // floor(B^(2k) / d) for d of k limbs (trimmed, not zero): newton step from
+  // the reciprocal of the top half of d, then exact correction (O(M(k))).
+  // garbage once cancelled (products are, and corrections are skipped)
+  static void reciprocal(const cs_vlimb& d, cs_vlimb& v) {
+    size_t k = d.size();
+    if (k <= 8) {
+      reciprocalSmall(d, v);
+      return;
+    }
+    cs_vlimb rem(2 * k + 1, 0);  // B^(2k), then B^(2k) - d * v
+    rem.back() = 1;
+    // top h limbs give 2h >= k + 3 correct limbs after one step
+    size_t h = k / 2 + 2;
+    cs_vlimb dh(d.end() - h, d.end()), vh, t, e;
+    reciprocal(dh, vh);
+    if (BigIntegerContext::Cancelled()) return;
+    v.assign(k - h, 0);  // x0 = vh * B^(k-h)
+    v.insert(v.end(), vh.begin(), vh.end());
+    // x1 = x0 + x0 * (B^(2k) - d * x0) / B^(2k)
+    mul(d, v, t);
+    if (BigIntegerContext::Cancelled()) return;
+    bool over = cmp(t, rem) > 0;
+    e = over ? t : rem;
+    subTo(e, over ? rem : t);
+    mul(v, e, t);
+    if (BigIntegerContext::Cancelled()) return;
+    e.assign(t.begin() + std::min(t.size(), 2 * k), t.end());
+    if (over) {
+      addTo(e, cs_vlimb(1, 1));  // rounds towards exact result
+      if (cmp(v, e) < 0) e = v;
+      subTo(v, e);
+    } else {
+      addTo(v, e);
+    }
+    // d * v <= B^(2k) < d * (v + 1) (a few steps)
+    mul(d, v, t);
+    if (BigIntegerContext::Cancelled()) return;
+    while (cmp(t, rem) > 0) {
+      subTo(t, d);
+      subTo(v, cs_vlimb(1, 1));
+    }
+    subTo(rem, t);
+    while (cmp(rem, d) >= 0) {
+      subTo(rem, d);
+      addTo(v, cs_vlimb(1, 1));
+    }
+  }
+
+  // q = x / d, r = x % d for x < B^(2k) (d of k limbs, v = reciprocal(d)):
+  // Barrett reduction (HAC 14.42), at most two corrections (garbage once
+  // cancelled)
+  static void divRem(const cs_vlimb& x, const cs_vlimb& d, const cs_vlimb& v,
+                     cs_vlimb& q, cs_vlimb& r) {
+    size_t k = d.size();
+    r = x;
+    q.clear();
+    if (x.size() < k) return;  // x < d
+    cs_vlimb q1(x.begin() + (k - 1), x.end()), t;
+    mul(q1, v, t);
+    if (t.size() > k + 1) q.assign(t.begin() + (k + 1), t.end());
+    mul(q, d, t);
+    if (BigIntegerContext::Cancelled()) return;
+    subTo(r, t);
+    while (cmp(r, d) >= 0) {
+      subTo(r, d);
+      addTo(q, cs_vlimb(1, 1));
+    }
+  }
+
+  // q = x / d, r = x % d for any x (d trimmed, not zero): long division by
+  // blocks of d.size() limbs from the top, each one by Barrett over a single
+  // reciprocal. false once cancelled (checked between blocks)
+  static bool divRem(const cs_vlimb& x, const cs_vlimb& d, cs_vlimb& q,
+                     cs_vlimb& r) {
+    size_t k = d.size();
+    q.clear();
+    r = x;
+    if (x.size() < k) return true;  // x < d
+    cs_vlimb v, t, qb;
+    reciprocal(d, v);
+    size_t nblocks = (x.size() + k - 1) / k;
+    q.assign(nblocks * k, 0);
+    r.clear();
+    for (size_t b = nblocks; b-- > 0;) {
+      if (BigIntegerContext::Cancelled()) return false;
+      // t = r * B^k + block (< d * B^k)
+      size_t lo = b * k;
+      t.assign(x.begin() + lo, x.begin() + std::min(x.size(), lo + k));
+      if (!r.empty()) {
+        t.resize(k, 0);
+        t.insert(t.end(), r.begin(), r.end());
+      }
+      trim(t);
+      divRem(t, d, v, qb, r);
+      std::copy(qb.begin(), qb.end(), q.begin() + lo);
+    }
+    trim(q);
+    return !BigIntegerContext::Cancelled();
+  }
+
+  // -1, 0 or 1 (trimmed)
+  static int cmp(const cs_vlimb& a, const cs_vlimb& b) {
+    if (a.size() != b.size()) return (a.size() < b.size()) ? -1 : 1;
+    for (size_t i = a.size(); i-- > 0;)
+      if (a[i] != b[i]) return (a[i] < b[i]) ? -1 : 1;
+    return 0;
+  }
+
+  // 10^e (e <= DEC_DIGITS)
+  static cs_limb pow10(int e) {
+    static constexpr cs_uint64 table[20] = {1ull,
+                                            10ull,
+                                            100ull,
+                                            1000ull,
+                                            10000ull,
+                                            100000ull,
+                                            1000000ull,
+                                            10000000ull,
+                                            100000000ull,
+                                            1000000000ull,
+                                            10000000000ull,
+                                            100000000000ull,
+                                            1000000000000ull,
+                                            10000000000000ull,
+                                            100000000000000ull,
+                                            1000000000000000ull,
+                                            10000000000000000ull,
+                                            100000000000000000ull,
+                                            1000000000000000000ull,
+                                            10000000000000000000ull};
+    return static_cast<cs_limb>(table[e]);
+  }
+
+  // largest power of 'base' that fits a limb: base^width
+  static cs_limb radixChunk(int base, int& width) {
+    if (base == 10) {
+      width = DEC_DIGITS;
+      return DEC_BASE;
+    }
+    cs_limb p = 1;
+    width = 0;
+    while (p <= static_cast<cs_limb>(~cs_limb{0}) / base) {
+      p *= base;
+      width++;
+    }
+    return p;
+  }
+
+  // big-endian magnitude bytes of a single limb
+  static void toBytes(cs_limb v, cs_byte* mag) {
+    for (size_t i = 0; i < sizeof(cs_limb); i++, v >>= 8)
+      mag[sizeof(cs_limb) - 1 - i] = static_cast<cs_byte>(v);
+  }
+
+  // big-endian magnitude bytes to little-endian limbs (no leading zero limbs)
+  static void fromBytes(const cs_byte* mag, size_t n, cs_vlimb& limbs) {
+    limbs.assign((n + sizeof(cs_limb) - 1) / sizeof(cs_limb), 0);
+    for (size_t i = 0; i < n; i++)
+      limbs[i / sizeof(cs_limb)] |= static_cast<cs_limb>(mag[n - 1 - i])
+                                    << (8 * (i % sizeof(cs_limb)));
+    trim(limbs);
+  }
+
+  // little-endian limbs to big-endian magnitude bytes (may keep leading zeroes)
+  static void toBytes(const cs_vlimb& limbs, cs_vbyte& mag) {
+    mag.resize(limbs.size() * sizeof(cs_limb));
+    for (size_t i = 0; i < mag.size(); i++)
+      mag[mag.size() - 1 - i] = static_cast<cs_byte>(
+          limbs[i / sizeof(cs_limb)] >> (8 * (i % sizeof(cs_limb))));
+  }
+
+  static void trim(cs_vlimb& limbs) {
+    while (!limbs.empty() && (limbs.back() == 0)) limbs.pop_back();
+  }
+
+  // limbs = limbs * m + a
+  static void mulAdd(cs_vlimb& limbs, cs_limb m, cs_limb a) {
+    cs_limb carry = a;
+    for (cs_limb& l : limbs) {
+      cs_dlimb t = static_cast<cs_dlimb>(l) * m + carry;
+      l = static_cast<cs_limb>(t);
+      carry = static_cast<cs_limb>(t >> BITS);
+    }
+    if (carry != 0) limbs.push_back(carry);
+  }
+
+  // r[0..nr) += a[0..na) (na <= nr), returns carry
+  static cs_limb add(cs_limb* r, size_t nr, const cs_limb* a, size_t na) {
+    cs_limb carry = 0;
+    for (size_t i = 0; i < nr; i++) {
+      if ((i >= na) && (carry == 0)) break;
+      cs_limb x = (i < na) ? a[i] : 0;
+      cs_limb t = r[i] + x;
+      cs_limb c1 = (t < x);
+      r[i] = t + carry;
+      carry = c1 | (r[i] < t);
+    }
+    return carry;
+  }
+
+  // r[0..nr) -= a[0..na) (na <= nr, r >= a)
+  static void sub(cs_limb* r, size_t nr, const cs_limb* a, size_t na) {
+    cs_limb borrow = 0;
+    for (size_t i = 0; i < nr; i++) {
+      if ((i >= na) && (borrow == 0)) break;
+      cs_limb x = (i < na) ? a[i] : 0;
+      cs_limb t = r[i] - x;
+      cs_limb b1 = (r[i] < x);
+      r[i] = t - borrow;
+      borrow = b1 | (t < borrow);
+    }
+  }
+
+  // r[0..na+nb) = a * b (r does not overlap a or b)
+  static void mul(const cs_limb* a, size_t na, const cs_limb* b, size_t nb,
+                  cs_limb* r) {
+    if (na < nb) {
+      std::swap(a, b);
+      std::swap(na, nb);
+    }
+    std::fill(r, r + na + nb, 0);
+    if (nb == 0) return;
+    if (nb < KARATSUBA) {
+      for (size_t j = 0; j < nb; j++) {
+        cs_limb carry = 0;
+        for (size_t i = 0; i < na; i++) {
+          cs_dlimb t = static_cast<cs_dlimb>(a[i]) * b[j] + r[i + j] + carry;
+          r[i + j] = static_cast<cs_limb>(t);
+          carry = static_cast<cs_limb>(t >> BITS);
+        }
+        r[na + j] = carry;
+      }
+      return;
+    }
+    if ((nb >= POLL_LIMBS) && BigIntegerContext::Cancelled()) return;
+    size_t h = (na + 1) / 2;
+    if (nb <= h) {
+      // unbalanced: a0 * b + (a1 * b) << h
+      mul(a, h, b, nb, r);
+      cs_vlimb t(na - h + nb);
+      mul(a + h, na - h, b, nb, t.data());
+      add(r + h, na + nb - h, t.data(), t.size());
+      return;
+    }
+    // karatsuba: a = a1*B^h + a0, b = b1*B^h + b0
+    // a*b = z2*B^2h + (z1 - z2 - z0)*B^h + z0, z1 = (a0 + a1)*(b0 + b1)
+    mul(a, h, b, h, r);                               // z0
+    mul(a + h, na - h, b + h, nb - h, r + 2 * h);     // z2
+    cs_vlimb s1(a, a + h), s2(b, b + h);
+    s1.push_back(add(s1.data(), h, a + h, na - h));  // a0 + a1
+    s2.push_back(add(s2.data(), h, b + h, nb - h));  // b0 + b1
+    cs_vlimb z1(2 * h + 2);
+    mul(s1.data(), h + 1, s2.data(), h + 1, z1.data());
+    sub(z1.data(), z1.size(), r, 2 * h);
+    sub(z1.data(), z1.size(), r + 2 * h, na + nb - 2 * h);
+    trim(z1);
+    add(r + h, na + nb - h, z1.data(), z1.size());
+  }
+
+  static void mul(const cs_vlimb& a, const cs_vlimb& b, cs_vlimb& r) {
+    r.resize(a.size() + b.size());
+    mul(a.data(), a.size(), b.data(), b.size(), r.data());
+    trim(r);
+  }
+
+  // end of decimal digit run starting at 'p'
+  static const char* decimalRun(const char* p, const char* last) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for (; last - p >= 8; p += 8)
+      if (!isDecimal8(load8(p))) break;
+#endif
+    while ((p != last) && (*p >= '0') && (*p <= '9')) p++;
+    return p;
+  }
+
+  // value of 'len' decimal digits (len <= DEC_DIGITS)
+  static cs_limb decimalChunk(const char* p, int len) {
+    cs_limb v = 0;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for (; len >= 8; len -= 8, p += 8) v = v * 100000000u + decimal8(load8(p));
+#endif
+    for (; len > 0; len--) v = v * 10 + (*p++ - '0');
+    return v;
+  }
+
+  // magnitude of decimal digits [first, last) (all digits) into 'limbs'.
+  // long inputs are combined by halves (subquadratic with karatsuba)
+  static void fromDecimal(const char* first, const char* last,
+                          cs_vlimb& limbs) {
+    size_t n = last - first;
+    limbs.clear();
+    if (n == 0) return;
+    size_t nchunks = (n + DEC_DIGITS - 1) / DEC_DIGITS;
+    int len = static_cast<int>(n - (nchunks - 1) * DEC_DIGITS);  // first one
+    if (nchunks <= DEC_SPLIT) {
+      limbs.push_back(decimalChunk(first, len));
+      for (const char* p = first + len; p != last; p += DEC_DIGITS)
+        mulAdd(limbs, DEC_BASE, decimalChunk(p, DEC_DIGITS));
+      trim(limbs);
+      return;
+    }
+    cs_vlimb& chunks = scratch().chunks;  // most significant first
+    chunks.clear();
+    for (const char* p = first; p != last; p += len, len = DEC_DIGITS)
+      chunks.push_back(decimalChunk(p, len));
+    combineChunks(10, nchunks, limbs);
+  }
+
+  // magnitude of digits [first, last) (all digits of radix 'base', not a
+  // power of two) into 'limbs', as fromDecimal
+  static void fromRadix(const char* first, const char* last, int base,
+                        cs_vlimb& limbs) {
+    size_t n = last - first;
+    limbs.clear();
+    if (n == 0) return;
+    int width;
+    cs_limb chunkBase = radixChunk(base, width);
+    size_t nchunks = (n + width - 1) / width;
+    int len = static_cast<int>(n - (nchunks - 1) * width);  // first one
+    cs_vlimb& chunks = scratch().chunks;  // most significant first
+    chunks.clear();
+    for (const char* p = first; p != last; p += len, len = width) {
+      cs_limb chunk = 0;
+      for (int k = 0; k < len; k++)
+        chunk = chunk * base + Helper::digitValue(p[k], base);
+      chunks.push_back(chunk);
+    }
+    if (nchunks <= DEC_SPLIT) {
+      for (cs_limb chunk : chunks) mulAdd(limbs, chunkBase, chunk);
+      trim(limbs);
+      return;
+    }
+    combineChunks(base, nchunks, limbs);
+  }
+
+  // magnitude 'x' (destroyed) to chunks of radix 'base' (see radixChunk),
+  // least significant first, may have leading zero chunks. long inputs are
+  // split by halves over the shared powers (inverse of fromChunks). false
+  // once current BigIntegerContext is cancelled
+  static bool toChunks(int base, cs_vlimb& x, cs_vlimb& chunks) {
+    int width;
+    cs_limb chunkBase = radixChunk(base, width);
+    chunks.clear();
+    if (x.empty()) return true;
+    // upper bound: bits of x over whole bits of chunkBase
+    int cbits = BITS - 1;
+    while ((chunkBase >> cbits) == 0) cbits--;
+    size_t xbits = x.size() * BITS;
+    for (cs_limb top = x.back(); (top >> (BITS - 1)) == 0; top <<= 1) xbits--;
+    size_t nchunks = xbits / cbits + 1;
+    if (nchunks <= DEC_SPLIT) {
+      while (!x.empty()) chunks.push_back(divRem(x, chunkBase));
+      return true;
+    }
+    size_t levels = 1;  // x < chunkBase^(2^levels) = pw[levels - 1]^2
+    while ((size_t{1} << levels) < nchunks) levels++;
+    std::vector<const cs_vlimb*> pw, inv;
+    std::vector<cs_vlimb> own, ownInv;
+    powers(base, levels, pw, own);
+    reciprocals(base, pw, inv, ownInv);
+    chunks.assign(size_t{1} << levels, 0);
+    splitChunks(x, levels - 1, pw, inv, chunkBase, chunks, 0);
+    return !BigIntegerContext::Cancelled();
+  }
+
+  // limbs = limbs / d (trimmed), returns remainder
+  static cs_limb divRem(cs_vlimb& limbs, cs_limb d) {
+    cs_limb rem = 0;
+    for (size_t i = limbs.size(); i-- > 0;) {
+      cs_dlimb t = (static_cast<cs_dlimb>(rem) << BITS) | limbs[i];
+      limbs[i] = static_cast<cs_limb>(t / d);
+      rem = static_cast<cs_limb>(t % d);
+    }
+    trim(limbs);
+    return rem;
+  }
+
+ private:
+  static cs_uint64 load8(const char* p) {
+    cs_uint64 v;
+    std::memcpy(&v, p, 8);
+    return v;
+  }
+
+  // 8 chars are all in '0'..'9'
+  static bool isDecimal8(cs_uint64 v) {
+    return (((v & 0xf0f0f0f0f0f0f0f0) |
+             (((v + 0x0606060606060606) & 0xf0f0f0f0f0f0f0f0) >> 4)) ==
+            0x3333333333333333);
+  }
+
+  // value of 8 decimal chars (first char is lowest byte)
+  static cs_uint32 decimal8(cs_uint64 v) {
+    v -= 0x3030303030303030;
+    v = (v * 10) + (v >> 8);  // pairs of digits
+    v = (((v & 0x000000ff000000ff) * (100 + (1000000ull << 32))) +
+         (((v >> 16) & 0x000000ff000000ff) * (1 + (10000ull << 32)))) >>
+        32;
+    return static_cast<cs_uint32>(v);
+  }
+
+  // scratch chunks (radix 'base', most significant first) into limbs, by
+  // halves over the shared powers
+  static void combineChunks(int base, size_t nchunks, cs_vlimb& limbs) {
+    size_t levels = 1;  // pw[j] = chunkBase^(2^j)
+    while ((size_t{2} << (levels - 1)) < nchunks) levels++;
+    std::vector<const cs_vlimb*> pw;
+    std::vector<cs_vlimb> own;
+    powers(base, levels, pw, own);
+    fromChunks(scratch().chunks.data(), nchunks, pw, limbs);
+  }
+
+  // chunks[0..n) (base *pw[0], most significant first, within scratch
+  // chunks) into limbs
+  static void fromChunks(const cs_limb* chunks, size_t n,
+                         const std::vector<const cs_vlimb*>& pw,
+                         cs_vlimb& limbs) {
+    limbs.clear();
+    if (n <= DEC_SPLIT) {
+      for (size_t i = 0; i < n; i++) mulAdd(limbs, (*pw[0])[0], chunks[i]);
+      const cs_vlimb& all = scratch().chunks;
+      BigIntegerContext::Poll("from_chars", chunks + n - all.data(),
+                              all.size());
+      return;
+    }
+    if (BigIntegerContext::Cancelled()) return;
+    // low part has 2^j chunks: value = high * pw[j] + low
+    size_t j = 0;
+    while ((size_t{2} << j) < n) j++;
+    size_t low = size_t{1} << j;
+    cs_vlimb hi, lo;
+    fromChunks(chunks, n - low, pw, hi);
+    fromChunks(chunks + n - low, low, pw, lo);
+    mul(hi, *pw[j], limbs);
+    if (limbs.size() < lo.size()) limbs.resize(lo.size(), 0);
+    limbs.push_back(0);
+    add(limbs.data(), limbs.size(), lo.data(), lo.size());
+    trim(limbs);
+  }
+
+  // x < pw[j]^2 into 2^(j+1) chunks from chunks[at] (least significant
+  // first)
+  static void splitChunks(cs_vlimb& x, size_t j,
+                          const std::vector<const cs_vlimb*>& pw,
+                          const std::vector<const cs_vlimb*>& inv,
+                          cs_limb chunkBase, cs_vlimb& chunks, size_t at) {
+    size_t n = size_t{2} << j;
+    if (n <= DEC_SPLIT) {
+      for (size_t i = 0; (i < n) && !x.empty(); i++)
+        chunks[at + i] = divRem(x, chunkBase);
+      BigIntegerContext::Poll("to_chars", at + n, chunks.size());
+      return;
+    }
+    if (BigIntegerContext::Cancelled()) return;
+    // x = high * pw[j] + low, low has 2^j chunks
+    cs_vlimb high, low;
+    divRem(x, *pw[j], *inv[j], high, low);
+    splitChunks(low, j - 1, pw, inv, chunkBase, chunks, at);
+    splitChunks(high, j - 1, pw, inv, chunkBase, chunks, at + n / 2);
+  }
+
+  // floor(B^(2k) / d), bit by bit (d of k <= 8 limbs)
+  static void reciprocalSmall(const cs_vlimb& d, cs_vlimb& v) {
+    size_t nbits = 2 * d.size() * BITS;
+    v.assign(2 * d.size() + 1, 0);
+    cs_vlimb r;
+    for (size_t i = nbits + 1; i-- > 0;) {
+      // r = 2r + bit i of B^(2k)
+      cs_limb carry = (i == nbits);
+      for (cs_limb& l : r) {
+        cs_limb top = l >> (BITS - 1);
+        l = (l << 1) | carry;
+        carry = top;
+      }
+      if (carry != 0) r.push_back(carry);
+      if (cmp(r, d) >= 0) {
+        subTo(r, d);
+        v[i / BITS] |= cs_limb{1} << (i % BITS);
+      }
+    }
+    trim(v);
+  }
+
+  // a += b (trimmed)
+  static void addTo(cs_vlimb& a, const cs_vlimb& b) {
+    if (a.size() < b.size()) a.resize(b.size(), 0);
+    a.push_back(0);
+    add(a.data(), a.size(), b.data(), b.size());
+    trim(a);
+  }
+
+  // a -= b (a >= b, trimmed)
+  static void subTo(cs_vlimb& a, const cs_vlimb& b) {
+    sub(a.data(), a.size(), b.data(), b.size());
+    trim(a);
+  }
+
+  struct PowerCache {
+    std::atomic<const cs_vlimb*> level[64] = {};
+    std::atomic<const cs_vlimb*> inverse[64] = {};  // reciprocal(*level[k])
+    std::atomic<size_t> limit{64};  // first level not kept
+    std::mutex lock;                // writers
+    std::vector<std::unique_ptr<cs_vlimb>> owned;
+  };
+
+  static PowerCache& powerCache(int base) {
+    static PowerCache caches[65];  // by radix
+    return caches[base];
+  }
+};
+
+}  // namespace csbiginteger
+
+#endif  // CS_BIGINTEGER_LIMBS_HPP
@@ -0,0 +1,109 @@
+// SPDX-License-Identifier:  MIT
+// Copyright (C) 2020-2022 - csbiginteger-cpp project
+
+#ifndef CS_BIGINTEGER_REDUCTION_HPP
+#define CS_BIGINTEGER_REDUCTION_HPP
+
+// c++
+#include <algorithm>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+// internal classes
+#include <csbiginteger/BigInteger.h>
+#include <csbiginteger/BigIntegerAccumulator.hpp>
+
+// Reductions over ranges of BigInteger: Sum, Product and Dot.
+//
+// Ranges are split across threads (nthreads = 0 means hardware concurrency).
+// Sum and Dot accumulate each part on a BigIntegerAccumulator, so carries are
+// only propagated when parts are combined at the end.
+// Product uses BigInteger::ProductTree (operands of similar size).
+// Any Error() element results in Error().
+//
+// Worker threads allocate from the default memory resource; only the final
+// result follows the MemoryResourceScope of the calling thread.
+
+namespace csbiginteger {
+
+// minimum number of elements handled by each thread
+constexpr size_t REDUCTION_GRAIN = 1024;
+
+// number of threads for a reduction of 'n' elements (0 means hardware)
+inline unsigned ReductionThreads(size_t n, unsigned nthreads) {
+  if (nthreads == 0)
+    nthreads = std::max(1u, std::thread::hardware_concurrency());
+  size_t most = std::max<size_t>(1, n / REDUCTION_GRAIN);
+  return static_cast<unsigned>(std::min<size_t>(nthreads, most));
+}
+
+// run 'part(first, last, t)' over 'nthreads' consecutive parts of the range
+template <class It, class Part>
+inline void ReductionParts(It first, size_t n, unsigned nthreads, Part part) {
+  std::vector<std::thread> workers;
+  It begin = first;
+  for (unsigned t = 0; t < nthreads; t++) {
+    size_t len = n / nthreads + (t < n % nthreads ? 1 : 0);
+    It end = std::next(begin, len);
+    if (t + 1 < nthreads)
+      workers.emplace_back(part, begin, end, t);
+    else
+      part(begin, end, t);  // last part on calling thread
+    begin = end;
+  }
+  for (auto& w : workers) w.join();
+}
+
+template <class It>
+inline BigInteger Sum(It first, It last, unsigned nthreads = 0) {
+  size_t n = std::distance(first, last);
+  nthreads = ReductionThreads(n, nthreads);
+  std::vector<BigIntegerAccumulator> parts(nthreads);
+  ReductionParts(first, n, nthreads, [&parts](It begin, It end, unsigned t) {
+    for (It it = begin; it != end; ++it) parts[t].add(*it);
+  });
+  for (unsigned t = 1; t < nthreads; t++) parts[0].merge(parts[t]);
+  return parts[0].ToBigInteger();
+}
+
+template <class Range>
+inline BigInteger Sum(const Range& values, unsigned nthreads = 0) {
+  return Sum(std::begin(values), std::end(values), nthreads);
+}
+
+template <class It>
+inline BigInteger Product(It first, It last, unsigned nthreads = 0) {
+  size_t n = std::distance(first, last);
+  return BigInteger::ProductTree(first, last, ReductionThreads(n, nthreads));
+}
+
+template <class Range>
+inline BigInteger Product(const Range& values, unsigned nthreads = 0) {
+  return Product(std::begin(values), std::end(values), nthreads);
+}
+
+// sum of a[i]*b[i] (Error() if sizes are different)
+template <class RangeA, class RangeB>
+inline BigInteger Dot(const RangeA& a, const RangeB& b, unsigned nthreads = 0) {
+  size_t n = std::distance(std::begin(a), std::end(a));
+  if (n != static_cast<size_t>(std::distance(std::begin(b), std::end(b))))
+    return BigInteger::Error();
+  using ItA = decltype(std::begin(a));
+  auto firstB = std::begin(b);
+  nthreads = ReductionThreads(n, nthreads);
+  std::vector<BigIntegerAccumulator> parts(nthreads);
+  ItA firstA = std::begin(a);
+  ReductionParts(firstA, n, nthreads,
+                 [&parts, firstA, firstB](ItA begin, ItA end, unsigned t) {
+                   auto itB = std::next(firstB, std::distance(firstA, begin));
+                   for (ItA it = begin; it != end; ++it, ++itB)
+                     parts[t].add((*it) * (*itB));
+                 });
+  for (unsigned t = 1; t < nthreads; t++) parts[0].merge(parts[t]);
+  return parts[0].ToBigInteger();
+}
+
+}  // namespace csbiginteger
+
+#endif  // CS_BIGINTEGER_REDUCTION_HPP
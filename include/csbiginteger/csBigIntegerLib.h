@@ -124,4 +124,96 @@ CSBIGINTEGER_EXTERN_C cs_int32 csbiginteger_pow(cs_byte* big, int sz_big,
                                                 int exp, cs_byte* vr,
                                                 int sz_vr);
 
+// ==========================
+// reductions (packed buffers)
+// ==========================
+// packed format: 'count' values in little-endian format, concatenated in 'vb'
+// ('sizes[i]' bytes each). Work is split across 'nthreads' threads (0 means
+// hardware concurrency).
+
+// perform vb[0] + ... + vb[count-1] and return its size (in bytes). output vr
+// must be pre-allocated
+CSBIGINTEGER_EXTERN_C cs_int32 csbiginteger_sum(cs_byte* vb, cs_int32* sizes,
+                                                int count, int nthreads,
+                                                cs_byte* vr, int sz_vr);
+
+// perform vb[0] * ... * vb[count-1] (balanced product tree) and return its
+// size (in bytes). output vr must be pre-allocated
+CSBIGINTEGER_EXTERN_C cs_int32 csbiginteger_product(cs_byte* vb,
+                                                    cs_int32* sizes, int count,
+                                                    int nthreads, cs_byte* vr,
+                                                    int sz_vr);
+
+// perform va[0]*vb[0] + ... + va[count-1]*vb[count-1] and return its size (in
+// bytes). output vr must be pre-allocated
+CSBIGINTEGER_EXTERN_C cs_int32 csbiginteger_dot(cs_byte* va, cs_int32* sizes_a,
+                                                cs_byte* vb, cs_int32* sizes_b,
+                                                int count, int nthreads,
+                                                cs_byte* vr, int sz_vr);
+
+// ==============================================
+// asynchronous rings (submission and completion)
+// ==============================================
+// a ring belongs to one caller thread, which submits operations (lock-free,
+// never blocks) and reaps their completions; 'nthreads' library workers
+// execute them. Buffers of a submission must stay valid until its completion
+// is reaped. At most 'entries' operations are in flight (submitted, not
+// reaped).
+
+enum csbiginteger_ring_op : cs_int32 {
+  CSBIGINTEGER_OP_ADD = 1,
+  CSBIGINTEGER_OP_SUB = 2,
+  CSBIGINTEGER_OP_MUL = 3,
+  CSBIGINTEGER_OP_DIV = 4,
+  CSBIGINTEGER_OP_MOD = 5,
+  CSBIGINTEGER_OP_SHL = 6,
+  CSBIGINTEGER_OP_SHR = 7,
+  CSBIGINTEGER_OP_POW = 8  // big1 ^ exp (big2 unused)
+};
+
+// submission: perform big1 'op' big2 into vr (as the synchronous methods)
+struct csbiginteger_sqe {
+  cs_int64 tag;  // returned in completion
+  cs_int32 op;
+  cs_byte* big1;
+  int sz_big1;
+  cs_byte* big2;
+  int sz_big2;
+  int exp;
+  cs_byte* vr;
+  int sz_vr;
+};
+
+// completion: 'result' is the size of vr (in bytes), 0 on error
+struct csbiginteger_cqe {
+  cs_int64 tag;
+  cs_int32 result;
+};
+
+struct csbiginteger_ring;
+
+// create ring for 'entries' operations in flight (rounded up to a power of
+// two) served by 'nthreads' workers (0 means hardware concurrency). returns
+// null on failure
+CSBIGINTEGER_EXTERN_C csbiginteger_ring* csbiginteger_ring_create(
+    int entries, int nthreads);
+
+// finish submitted operations and release ring (and its workers)
+CSBIGINTEGER_EXTERN_C void csbiginteger_ring_destroy(csbiginteger_ring* ring);
+
+// enqueue operation (return indicates failure: ring is full or op invalid,
+// 'true' is fine)
+CSBIGINTEGER_EXTERN_C bool csbiginteger_ring_submit(
+    csbiginteger_ring* ring, const csbiginteger_sqe* sqe);
+
+// reap up to 'max' completions into cqes and return how many. waits up to
+// 'timeout_ms' when none is ready (0 polls, -1 waits forever)
+CSBIGINTEGER_EXTERN_C int csbiginteger_ring_wait(csbiginteger_ring* ring,
+                                                 csbiginteger_cqe* cqes,
+                                                 int max, int timeout_ms);
+
+// descriptor (eventfd on linux, pipe elsewhere) readable when completions are
+// ready, for caller event loops (csbiginteger_ring_wait resets it)
+CSBIGINTEGER_EXTERN_C int csbiginteger_ring_fd(csbiginteger_ring* ring);
+
 #endif  // CSBIGINTEGER_LIB_H
@@ -13,7 +13,6 @@
 #include <vector>
 */
 #include <algorithm>
-#include <memory>  // unique_ptr
 #include <string>
 #include <utility>
 
@@ -74,31 +73,28 @@ class BigInteger final {
     return true;
   }
 
-  // used for global caching
-  static inline std::unique_ptr<BigInteger> _One;
-  static inline std::unique_ptr<BigInteger> _Zero;
-  static inline std::unique_ptr<BigInteger> _MinusOne;
-  static inline std::unique_ptr<BigInteger> _Error;
-
+  // used for global caching (function-local statics are initialized once,
+  // thread-safely)
   static const BigInteger One() {
-    if (!_One) _One = std::unique_ptr<BigInteger>(new BigInteger(1));
-    return *_One;
+    static const BigInteger* p = new BigInteger(1);
+    return *p;
   }
   static const BigInteger Zero() {
-    if (!_Zero) _Zero = std::unique_ptr<BigInteger>(new BigInteger(0));
-    return *_Zero;
+    static const BigInteger* p = new BigInteger(0);
+    return *p;
   }
   static const BigInteger MinusOne() {
-    if (!_MinusOne) _MinusOne = std::unique_ptr<BigInteger>(new BigInteger(-1));
-    return *_MinusOne;
+    static const BigInteger* p = new BigInteger(-1);
+    return *p;
   }
   // error biginteger (empty internal bytearray)
   static const BigInteger Error() {
-    if (!_Error) {
-      _Error = std::unique_ptr<BigInteger>(new BigInteger());
-      _Error->_data.clear();  // error biginteger (empty internal bytearray)
-    }
-    return *_Error;
+    static const BigInteger* p = []() {
+      BigInteger* e = new BigInteger();
+      e->_data.clear();  // error biginteger (empty internal bytearray)
+      return e;
+    }();
+    return *p;
   }
 
  public:
@@ -0,0 +1,416 @@
+// SPDX-License-Identifier:  MIT
+// Copyright (C) 2020-2022 - csbiginteger-cpp project
+
+// csbigintegerd: local batching compute server
+// usage: ./csbigintegerd [-j threads] [-b batch] [socket]
+//
+// one i/o thread polls all clients and reads every pipelined request
+// available, coalescing requests from many clients into batches of up to
+// 'batch' requests. batches go to a work-stealing pool (one deque per
+// worker, idle workers steal from the others); replies of a batch are
+// grouped per client and queued on its connection (asynchronously, tagged by
+// request id). client sockets are non-blocking: the i/o thread flushes
+// queued replies, waiting for POLLOUT on clients that do not read.
+
+// c
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <csbiginteger/BigInteger.h>
+#include <csbiginteger/Reduction.hpp>
+
+#include "csbigintegerd.h"
+
+using csbiginteger::BigInteger;
+using csbiginteger::cs_vbyte;
+
+constexpr cs_int32 MAX_FRAME = cs_int32{1} << 28;  // bytes per request/reply
+constexpr csbiginteger::cs_int64 MAX_FRAME_BITS =
+    csbiginteger::cs_int64{MAX_FRAME} * 8;
+constexpr size_t MAX_QUEUED = size_t{1} << 26;  // stop reading client above
+
+static std::atomic<bool> running{true};
+
+static int wakefd[2] = {-1, -1};  // pipe: workers queued replies
+
+static void csbigintegerd_stop(int) { running = false; }
+
+struct Connection {
+  int fd;
+  std::string in;  // pending (partial) input
+  std::mutex wmutex;  // guards 'out'
+  std::string out;    // replies queued by workers
+  std::string sending;  // replies being flushed (i/o thread only)
+  size_t sent{0};
+
+  explicit Connection(int fd) : fd(fd) {}
+  ~Connection() { ::close(fd); }
+
+  // true when replies are left after last flush (wait for POLLOUT)
+  bool blocked() const { return sent < sending.size(); }
+
+  // bytes waiting to be sent (i/o thread)
+  size_t queued() {
+    std::lock_guard<std::mutex> lock(wmutex);
+    return sending.size() - sent + out.size();
+  }
+
+  // sends queued replies until socket is full (false when client is gone)
+  bool flush() {
+    while (true) {
+      if (!blocked()) {
+        sending.clear();
+        sent = 0;
+        std::lock_guard<std::mutex> lock(wmutex);
+        if (out.empty()) return true;
+        sending.swap(out);
+      }
+      ssize_t k = ::send(fd, sending.data() + sent, sending.size() - sent,
+                         MSG_NOSIGNAL);
+      if (k < 0) return (errno == EAGAIN) || (errno == EWOULDBLOCK);
+      sent += k;
+    }
+  }
+};
+
+struct Job {
+  std::shared_ptr<Connection> conn;
+  csbigintegerd_request h;
+  std::string payload;  // sizes and packed values
+};
+
+using Batch = std::vector<Job>;
+
+// evaluates a request (Error() when malformed, or result too large)
+static BigInteger evaluate(const Job& job) {
+  cs_int32 count = job.h.count;
+  if ((count < 0) ||
+      (static_cast<size_t>(count) * sizeof(cs_int32) > job.payload.size()))
+    return BigInteger::Error();
+  const char* p = job.payload.data();
+  const cs_byte* vb = reinterpret_cast<const cs_byte*>(p) +
+                      count * sizeof(cs_int32);
+  size_t left = job.payload.size() - count * sizeof(cs_int32);
+  std::vector<BigInteger> v;
+  v.reserve(count);
+  for (cs_int32 i = 0; i < count; i++) {
+    cs_int32 sz;
+    std::memcpy(&sz, p + i * sizeof(cs_int32), sizeof(sz));
+    if ((sz <= 0) || (static_cast<size_t>(sz) > left))
+      return BigInteger::Error();
+    v.emplace_back(cs_vbyte(vb, vb + sz));
+    vb += sz;
+    left -= sz;
+  }
+  if (left != 0) return BigInteger::Error();
+  switch (job.h.op) {
+    case CSBIGINTEGERD_SUM:
+      return csbiginteger::Sum(v, 1);
+    case CSBIGINTEGERD_PRODUCT:
+      return csbiginteger::Product(v, 1);
+    case CSBIGINTEGERD_DOT: {
+      if (count % 2 != 0) return BigInteger::Error();
+      std::vector<BigInteger> b(v.begin() + count / 2, v.end());
+      v.resize(count / 2);
+      return csbiginteger::Dot(v, b, 1);
+    }
+    default:
+      break;
+  }
+  if (count != 2) return BigInteger::Error();
+  switch (job.h.op) {
+    case CSBIGINTEGERD_ADD:
+      return v[0] + v[1];
+    case CSBIGINTEGERD_SUB:
+      return v[0] - v[1];
+    case CSBIGINTEGERD_MUL:
+      return v[0] * v[1];
+    case CSBIGINTEGERD_DIV:
+      return v[0] / v[1];
+    case CSBIGINTEGERD_MOD:
+      return v[0] % v[1];
+    case CSBIGINTEGERD_SHL: {
+      // non-negative int64 count, result must fit a reply frame
+      csbiginteger::cs_int64 s;
+      if (!v[1].TryToInt64(s) || (s < 0) || (s >= MAX_FRAME_BITS) ||
+          (v[0].GetBitLength() + s > MAX_FRAME_BITS))
+        return BigInteger::Error();
+      return v[0] << s;
+    }
+    case CSBIGINTEGERD_SHR: {
+      // non-negative int64 count; engine shifts take counts below bit length
+      csbiginteger::cs_int64 s;
+      if (!v[1].TryToInt64(s) || (s < 0)) return BigInteger::Error();
+      if (s >= v[0].GetBitLength())
+        return (v[0] < BigInteger::Zero()) ? BigInteger::MinusOne()
+                                           : BigInteger::Zero();
+      return v[0] >> s;
+    }
+    case CSBIGINTEGERD_POW: {
+      csbiginteger::cs_int64 e;
+      if (!v[1].TryToInt64(e) || (e < 0) || (e > (1 << 30)))
+        return BigInteger::Error();
+      // at least (bits - 1) * e bits
+      if ((v[0].GetBitLength() - 1) * e >= MAX_FRAME_BITS)
+        return BigInteger::Error();
+      return BigInteger::Pow(v[0], static_cast<cs_int32>(e));
+    }
+    default:
+      return BigInteger::Error();
+  }
+}
+
+// evaluates a batch and queues replies (once per client), then wakes the
+// i/o thread
+static void process(Batch& batch) {
+  std::vector<std::pair<Connection*, std::string>> out;
+  for (Job& job : batch) {
+    cs_vbyte data;
+    try {
+      BigInteger r = evaluate(job);
+      if (!r.IsError() && (r.Length() <= MAX_FRAME)) data = r.ToByteArray();
+    } catch (const std::bad_alloc&) {
+      data.clear();  // error reply
+    } catch (const std::length_error&) {
+      data.clear();
+    }
+    csbigintegerd_response h{static_cast<cs_int32>(data.size()), job.h.id,
+                             static_cast<cs_int32>(data.size())};
+    if (out.empty() || (out.back().first != job.conn.get()))
+      out.emplace_back(job.conn.get(), std::string());
+    std::string& s = out.back().second;
+    s.append(reinterpret_cast<const char*>(&h), sizeof(h));
+    s.append(reinterpret_cast<const char*>(data.data()), data.size());
+  }
+  for (auto& [conn, s] : out) {
+    std::lock_guard<std::mutex> lock(conn->wmutex);
+    if (conn->out.empty())
+      conn->out.swap(s);
+    else
+      conn->out += s;
+  }
+  batch.clear();  // releases connections
+  char c = 0;
+  (void)!::write(wakefd[1], &c, 1);  // full pipe: already woken
+}
+
+// work-stealing pool: submit() deals batches round-robin to worker deques;
+// a worker takes from the front of its own deque, or steals from the back of
+// another one
+class Pool {
+ public:
+  explicit Pool(unsigned nthreads) : queues(nthreads) {
+    for (unsigned t = 0; t < nthreads; t++)
+      threads.emplace_back([this, t]() { work(t); });
+  }
+
+  ~Pool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    cv.notify_all();
+    for (std::thread& t : threads) t.join();
+  }
+
+  void submit(Batch&& batch) {
+    Queue& q = queues[next++ % queues.size()];
+    {
+      std::lock_guard<std::mutex> lock(q.mutex);
+      q.batches.push_back(std::move(batch));
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      pending++;
+    }
+    cv.notify_one();
+  }
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Batch> batches;
+  };
+
+  std::vector<Queue> queues;
+  std::vector<std::thread> threads;
+  size_t next{0};
+  std::mutex mutex;  // guards 'pending' and 'stopping'
+  std::condition_variable cv;
+  size_t pending{0};
+  bool stopping{false};
+
+  bool take(unsigned t, Batch& batch) {
+    for (size_t i = 0; i < queues.size(); i++) {
+      Queue& q = queues[(t + i) % queues.size()];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      if (q.batches.empty()) continue;
+      if (i == 0) {
+        batch = std::move(q.batches.front());
+        q.batches.pop_front();
+      } else {
+        batch = std::move(q.batches.back());
+        q.batches.pop_back();
+      }
+      return true;
+    }
+    return false;
+  }
+
+  void work(unsigned t) {
+    Batch batch;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this]() { return stopping || (pending > 0); });
+        if (pending == 0) return;  // stopping
+        pending--;
+      }
+      // a batch is reserved ('pending'), find it
+      while (!take(t, batch)) std::this_thread::yield();
+      process(batch);
+    }
+  }
+};
+
+// extracts complete requests from 'conn' input (false on malformed frame)
+static bool parse(const std::shared_ptr<Connection>& conn, Batch& jobs) {
+  std::string& in = conn->in;
+  size_t pos = 0;
+  while (in.size() - pos >= sizeof(csbigintegerd_request)) {
+    Job job;
+    std::memcpy(&job.h, in.data() + pos, sizeof(job.h));
+    if ((job.h.length < 0) || (job.h.length > MAX_FRAME)) return false;
+    if (in.size() - pos - sizeof(job.h) < static_cast<size_t>(job.h.length))
+      break;
+    job.conn = conn;
+    job.payload.assign(in, pos + sizeof(job.h), job.h.length);
+    jobs.push_back(std::move(job));
+    pos += sizeof(job.h) + job.h.length;
+  }
+  in.erase(0, pos);
+  return true;
+}
+
+int main(int argc, char** argv) {
+  unsigned nthreads = std::max(1u, std::thread::hardware_concurrency());
+  size_t batchSize = 256;
+  const char* path = CSBIGINTEGERD_SOCKET;
+  for (int i = 1; i < argc; i++) {
+    if ((std::strcmp(argv[i], "-j") == 0) && (i + 1 < argc))
+      nthreads = std::max(1, std::atoi(argv[++i]));
+    else if ((std::strcmp(argv[i], "-b") == 0) && (i + 1 < argc))
+      batchSize = std::max(1, std::atoi(argv[++i]));
+    else
+      path = argv[i];
+  }
+  sockaddr_un addr{};
+  if (std::strlen(path) >= sizeof(addr.sun_path)) {
+    std::fprintf(stderr, "csbigintegerd: socket path too long\n");
+    return 1;
+  }
+  addr.sun_family = AF_UNIX;
+  std::strcpy(addr.sun_path, path);
+  int lfd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  ::unlink(path);
+  if ((lfd < 0) ||
+      (::bind(lfd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) ||
+      (::listen(lfd, 128) != 0)) {
+    std::perror("csbigintegerd");
+    return 1;
+  }
+  ::signal(SIGINT, csbigintegerd_stop);
+  ::signal(SIGTERM, csbigintegerd_stop);
+  ::signal(SIGPIPE, SIG_IGN);
+  if ((::pipe(wakefd) != 0) || (::fcntl(wakefd[0], F_SETFL, O_NONBLOCK) != 0) ||
+      (::fcntl(wakefd[1], F_SETFL, O_NONBLOCK) != 0)) {
+    std::perror("csbigintegerd");
+    return 1;
+  }
+  std::fprintf(stderr, "csbigintegerd: %s (%u threads, batch %zu, engine %s)\n",
+               path, nthreads, batchSize, BigInteger::getEngine().c_str());
+  {
+    Pool pool(nthreads);
+    std::vector<std::shared_ptr<Connection>> conns;
+    std::vector<pollfd> fds;
+    std::vector<char> buf(size_t{1} << 16);
+    Batch jobs;
+    while (running) {
+      fds.assign(1, pollfd{lfd, POLLIN, 0});
+      fds.push_back(pollfd{wakefd[0], POLLIN, 0});
+      for (auto& c : conns) {
+        // clients that do not read their replies are not read either
+        short events = (c->queued() < MAX_QUEUED) ? POLLIN : 0;
+        if (c->blocked()) events |= POLLOUT;
+        fds.push_back(pollfd{c->fd, events, 0});
+      }
+      if (::poll(fds.data(), fds.size(), 100) <= 0) continue;
+      bool woken = (fds[1].revents & POLLIN) != 0;
+      while (woken && (::read(wakefd[0], buf.data(), buf.size()) > 0)) {
+      }
+      // flush queued replies, read every available request (all clients)
+      for (size_t i = conns.size(); i-- > 0;) {
+        short revents = fds[i + 2].revents;
+        bool alive = true;
+        if ((woken || (revents & POLLOUT)) && !conns[i]->flush())
+          alive = false;
+        if (alive && (revents & (POLLIN | POLLHUP | POLLERR))) {
+          while (true) {
+            ssize_t k = ::recv(conns[i]->fd, buf.data(), buf.size(), 0);
+            if (k > 0) {
+              conns[i]->in.append(buf.data(), k);
+              if (static_cast<size_t>(k) < buf.size()) break;
+            } else {
+              alive = (k < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK));
+              break;
+            }
+          }
+        }
+        if (!parse(conns[i], jobs)) alive = false;
+        if (!alive) {
+          ::shutdown(conns[i]->fd, SHUT_RDWR);
+          conns.erase(conns.begin() + i);  // closed with its last job
+        }
+      }
+      if (fds[0].revents & POLLIN) {
+        int cfd = ::accept(lfd, nullptr, nullptr);
+        if ((cfd >= 0) && (::fcntl(cfd, F_SETFL, O_NONBLOCK) != 0)) {
+          ::close(cfd);
+          cfd = -1;
+        }
+        if (cfd >= 0) conns.push_back(std::make_shared<Connection>(cfd));
+      }
+      // coalesced batches
+      for (size_t i = 0; i < jobs.size(); i += batchSize) {
+        size_t end = std::min(jobs.size(), i + batchSize);
+        pool.submit(Batch(std::make_move_iterator(jobs.begin() + i),
+                          std::make_move_iterator(jobs.begin() + end)));
+      }
+      jobs.clear();
+    }
+  }
+  ::close(lfd);
+  ::close(wakefd[0]);
+  ::close(wakefd[1]);
+  ::unlink(path);
+  return 0;
+}
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier:  MIT
+// Copyright (C) 2020-2022 - csbiginteger-cpp project
+
+#ifndef CSBIGINTEGERD_H
+#define CSBIGINTEGERD_H
+
+// csbigintegerd: local batching compute server (unix domain socket)
+//
+// wire format (native byte order, same host): each request is a
+// csbigintegerd_request header, followed by 'count' cs_int32 sizes and the
+// packed values (batch C API format: little-endian values, concatenated).
+// each reply is a csbigintegerd_response header, followed by 'size' bytes
+// (little-endian value, size 0 means error). 'length' counts bytes after the
+// header. requests may be pipelined; replies carry the request 'id' and may
+// come out of order.
+
+#include <csbiginteger/types.h>
+
+using cs_int32 = csbiginteger::cs_int32;
+using cs_byte = csbiginteger::cs_byte;
+
+#ifndef CSBIGINTEGER_EXTERN_C
+#define CSBIGINTEGER_EXTERN_C extern "C"
+#endif
+
+#define CSBIGINTEGERD_SOCKET "/tmp/csbigintegerd.sock"
+
+// operations: binary ones take 2 values (pow: exponent as second value,
+// shl/shr: non-negative bit count as second value), sum/product take 'count'
+// values, dot takes 'count' a values then 'count' b values (2*count in total)
+enum csbigintegerd_op : cs_int32 {
+  CSBIGINTEGERD_ADD = 1,
+  CSBIGINTEGERD_SUB = 2,
+  CSBIGINTEGERD_MUL = 3,
+  CSBIGINTEGERD_DIV = 4,
+  CSBIGINTEGERD_MOD = 5,
+  CSBIGINTEGERD_SHL = 6,
+  CSBIGINTEGERD_SHR = 7,
+  CSBIGINTEGERD_POW = 8,
+  CSBIGINTEGERD_SUM = 9,
+  CSBIGINTEGERD_PRODUCT = 10,
+  CSBIGINTEGERD_DOT = 11
+};
+
+struct csbigintegerd_request {
+  cs_int32 length;  // bytes after header (sizes and values)
+  cs_int32 id;
+  cs_int32 op;
+  cs_int32 count;  // number of values (sizes)
+};
+
+struct csbigintegerd_response {
+  cs_int32 length;  // bytes after header (same as 'size')
+  cs_int32 id;
+  cs_int32 size;  // value size (in bytes), 0 on error
+};
+
+// =============
+// client library
+// =============
+
+// connect to server on 'path' (CSBIGINTEGERD_SOCKET when null) and return its
+// descriptor (-1 on failure)
+CSBIGINTEGER_EXTERN_C int csbigintegerd_connect(const char* path);
+
+// close connection
+CSBIGINTEGER_EXTERN_C void csbigintegerd_close(int fd);
+
+// send request 'id' with 'count' packed values (does not wait for reply).
+// return indicates failure, 'true' is fine
+CSBIGINTEGER_EXTERN_C bool csbigintegerd_send(int fd, cs_int32 id, cs_int32 op,
+                                              cs_byte* vb, cs_int32* sizes,
+                                              int count);
+
+// receive next reply (any request), store its id and return its size (in
+// bytes). output vr must be pre-allocated (0 on error or small vr, -1 when
+// connection failed)
+CSBIGINTEGER_EXTERN_C cs_int32 csbigintegerd_recv(int fd, cs_int32* id,
+                                                  cs_byte* vr, int sz_vr);
+
+// send request and wait its reply (no other request must be in flight) and
+// return its size (in bytes). output vr must be pre-allocated
+CSBIGINTEGER_EXTERN_C cs_int32 csbigintegerd_call(int fd, cs_int32 op,
+                                                  cs_byte* vb, cs_int32* sizes,
+                                                  int count, cs_byte* vr,
+                                                  int sz_vr);
+
+#endif  // CSBIGINTEGERD_H
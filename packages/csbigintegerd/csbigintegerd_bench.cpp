@@ -0,0 +1,133 @@
+// SPDX-License-Identifier:  MIT
+// Copyright (C) 2020-2022 - csbiginteger-cpp project
+
+// csbigintegerd_bench: latency/throughput of csbigintegerd
+// usage: ./csbigintegerd_bench [-c clients] [-n requests] [-w window]
+//                              [-bits bits] [socket]
+//
+// each client keeps 'window' pipelined multiplications in flight (two
+// 'bits'-bit operands), checks every reply against the local engine and
+// records its latency.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <csbiginteger/BigInteger.h>
+
+#include "csbigintegerd.h"
+
+using csbiginteger::BigInteger;
+using csbiginteger::cs_vbyte;
+using Clock = std::chrono::steady_clock;
+
+struct ClientResult {
+  std::vector<double> latencies;  // microseconds
+  size_t errors{0};
+};
+
+static void client(const char* path, size_t n, size_t window, int bits,
+                   unsigned seed, ClientResult& res) {
+  int fd = csbigintegerd_connect(path);
+  if (fd < 0) {
+    res.errors = n;
+    return;
+  }
+  // operands (reused round-robin)
+  std::mt19937 rng(seed);
+  size_t nops = 64;
+  std::vector<cs_vbyte> a(nops), b(nops), expected(nops);
+  for (size_t i = 0; i < nops; i++) {
+    cs_vbyte x(bits / 8 + 1), y(bits / 8 + 1);
+    for (auto& c : x) c = static_cast<cs_byte>(rng());
+    for (auto& c : y) c = static_cast<cs_byte>(rng());
+    a[i] = BigInteger(x).ToByteArray();
+    b[i] = BigInteger(y).ToByteArray();
+    expected[i] = (BigInteger(a[i]) * BigInteger(b[i])).ToByteArray();
+  }
+  std::vector<Clock::time_point> sent(n);
+  std::vector<cs_byte> vr(2 * (bits / 8 + 2));
+  std::vector<cs_byte> vb;
+  size_t next = 0, done = 0;
+  while (done < n) {
+    for (; (next < n) && (next - done < window); next++) {
+      size_t k = next % nops;
+      vb.assign(a[k].begin(), a[k].end());
+      vb.insert(vb.end(), b[k].begin(), b[k].end());
+      cs_int32 sizes[2] = {static_cast<cs_int32>(a[k].size()),
+                           static_cast<cs_int32>(b[k].size())};
+      sent[next] = Clock::now();
+      if (!csbigintegerd_send(fd, static_cast<cs_int32>(next),
+                              CSBIGINTEGERD_MUL, vb.data(), sizes, 2)) {
+        res.errors += n - done;
+        csbigintegerd_close(fd);
+        return;
+      }
+    }
+    cs_int32 id;
+    cs_int32 sz = csbigintegerd_recv(fd, &id, vr.data(), vr.size());
+    if ((sz < 0) || (id < 0) || (static_cast<size_t>(id) >= next)) {
+      res.errors += n - done;
+      break;
+    }
+    res.latencies.push_back(
+        std::chrono::duration<double, std::micro>(Clock::now() - sent[id])
+            .count());
+    const cs_vbyte& e = expected[id % nops];
+    if ((static_cast<size_t>(sz) != e.size()) ||
+        !std::equal(e.begin(), e.end(), vr.begin()))
+      res.errors++;
+    done++;
+  }
+  csbigintegerd_close(fd);
+}
+
+int main(int argc, char** argv) {
+  size_t nclients = 4, n = 100000, window = 32;
+  int bits = 256;
+  const char* path = CSBIGINTEGERD_SOCKET;
+  for (int i = 1; i < argc; i++) {
+    bool more = i + 1 < argc;
+    if ((std::strcmp(argv[i], "-c") == 0) && more)
+      nclients = std::max(1, std::atoi(argv[++i]));
+    else if ((std::strcmp(argv[i], "-n") == 0) && more)
+      n = std::max(1, std::atoi(argv[++i]));
+    else if ((std::strcmp(argv[i], "-w") == 0) && more)
+      window = std::max(1, std::atoi(argv[++i]));
+    else if ((std::strcmp(argv[i], "-bits") == 0) && more)
+      bits = std::max(8, std::atoi(argv[++i]));
+    else
+      path = argv[i];
+  }
+  std::vector<ClientResult> results(nclients);
+  std::vector<std::thread> threads;
+  auto t0 = Clock::now();
+  for (size_t c = 0; c < nclients; c++)
+    threads.emplace_back(client, path, n, window, bits,
+                         static_cast<unsigned>(c + 1), std::ref(results[c]));
+  for (std::thread& t : threads) t.join();
+  double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+  std::vector<double> all;
+  size_t errors = 0;
+  for (ClientResult& r : results) {
+    all.insert(all.end(), r.latencies.begin(), r.latencies.end());
+    errors += r.errors;
+  }
+  std::sort(all.begin(), all.end());
+  auto pct = [&all](double p) {
+    return all.empty() ? 0.0 : all[static_cast<size_t>(p * (all.size() - 1))];
+  };
+  std::printf(
+      "csbigintegerd_bench: %zu clients x %zu mul (%d bits, window %zu)\n"
+      "  %.0f req/s in %.3f s, latency p50 %.1f us, p99 %.1f us, max %.1f "
+      "us, errors %zu\n",
+      nclients, n, bits, window, all.size() / secs, secs, pct(0.5), pct(0.99),
+      pct(1.0), errors);
+  return errors == 0 ? 0 : 1;
+}
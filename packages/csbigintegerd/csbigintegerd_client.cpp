@@ -0,0 +1,95 @@
+// SPDX-License-Identifier:  MIT
+// Copyright (C) 2020-2022 - csbiginteger-cpp project
+
+#include "csbigintegerd.h"
+
+// c
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <vector>
+
+// writes all 'n' bytes (false on failure)
+static bool csbigintegerd_write(int fd, const void* p, size_t n) {
+  const char* c = static_cast<const char*>(p);
+  while (n > 0) {
+    ssize_t k = ::send(fd, c, n, MSG_NOSIGNAL);
+    if (k <= 0) return false;
+    c += k;
+    n -= k;
+  }
+  return true;
+}
+
+// reads exactly 'n' bytes (false on failure)
+static bool csbigintegerd_read(int fd, void* p, size_t n) {
+  char* c = static_cast<char*>(p);
+  while (n > 0) {
+    ssize_t k = ::recv(fd, c, n, 0);
+    if (k <= 0) return false;
+    c += k;
+    n -= k;
+  }
+  return true;
+}
+
+CSBIGINTEGER_EXTERN_C int csbigintegerd_connect(const char* path) {
+  if (path == nullptr) path = CSBIGINTEGERD_SOCKET;
+  sockaddr_un addr{};
+  if (std::strlen(path) >= sizeof(addr.sun_path)) return -1;
+  addr.sun_family = AF_UNIX;
+  std::strcpy(addr.sun_path, path);
+  int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) return -1;
+  if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+    ::close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+CSBIGINTEGER_EXTERN_C void csbigintegerd_close(int fd) { ::close(fd); }
+
+CSBIGINTEGER_EXTERN_C bool csbigintegerd_send(int fd, cs_int32 id, cs_int32 op,
+                                              cs_byte* vb, cs_int32* sizes,
+                                              int count) {
+  if (count < 0) return false;
+  cs_int32 bytes = 0;
+  for (int i = 0; i < count; i++) bytes += sizes[i];
+  // single write for header, sizes and (small) values
+  std::vector<char> msg(sizeof(csbigintegerd_request) +
+                        count * sizeof(cs_int32) + bytes);
+  csbigintegerd_request h{
+      static_cast<cs_int32>(msg.size() - sizeof(csbigintegerd_request)), id, op,
+      count};
+  char* p = msg.data();
+  std::memcpy(p, &h, sizeof(h));
+  p += sizeof(h);
+  if (count > 0) std::memcpy(p, sizes, count * sizeof(cs_int32));
+  p += count * sizeof(cs_int32);
+  if (bytes > 0) std::memcpy(p, vb, bytes);
+  return csbigintegerd_write(fd, msg.data(), msg.size());
+}
+
+CSBIGINTEGER_EXTERN_C cs_int32 csbigintegerd_recv(int fd, cs_int32* id,
+                                                  cs_byte* vr, int sz_vr) {
+  csbigintegerd_response h;
+  if (!csbigintegerd_read(fd, &h, sizeof(h))) return -1;
+  *id = h.id;
+  if (h.length <= sz_vr)
+    return csbigintegerd_read(fd, vr, h.length) ? h.size : -1;
+  // small output: discard value
+  std::vector<cs_byte> skip(h.length);
+  return csbigintegerd_read(fd, skip.data(), h.length) ? 0 : -1;
+}
+
+CSBIGINTEGER_EXTERN_C cs_int32 csbigintegerd_call(int fd, cs_int32 op,
+                                                  cs_byte* vb, cs_int32* sizes,
+                                                  int count, cs_byte* vr,
+                                                  int sz_vr) {
+  if (!csbigintegerd_send(fd, 0, op, vb, sizes, count)) return -1;
+  cs_int32 id;
+  return csbigintegerd_recv(fd, &id, vr, sz_vr);
+}
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier:  MIT
+// Copyright (C) 2020-2022 - csbiginteger-cpp project
+
+// csbigintegerd_test: replies of a running csbigintegerd (edge cases)
+// usage: ./csbigintegerd_test [socket]
+
+#include <cstdio>
+#include <vector>
+
+#include <csbiginteger/BigInteger.h>
+
+#include "csbigintegerd.h"
+
+using csbiginteger::BigInteger;
+using csbiginteger::cs_vbyte;
+
+struct Case {
+  const char* name;
+  cs_int32 op;
+  BigInteger a, b;
+  BigInteger expected;  // Error() for an error reply (size 0)
+};
+
+int main(int argc, char** argv) {
+  const char* path = (argc > 1) ? argv[1] : CSBIGINTEGERD_SOCKET;
+  int fd = csbigintegerd_connect(path);
+  if (fd < 0) {
+    std::fprintf(stderr, "csbigintegerd_test: cannot connect '%s'\n", path);
+    return 1;
+  }
+  BigInteger big = BigInteger::Pow(BigInteger(2), 32) + BigInteger::One();
+  BigInteger huge = BigInteger::Pow(BigInteger(2), 64);
+  BigInteger error = BigInteger::Error();
+  std::vector<Case> cases = {
+      {"mul", CSBIGINTEGERD_MUL, BigInteger(3), BigInteger(-4),
+       BigInteger(-12)},
+      {"shl", CSBIGINTEGERD_SHL, BigInteger(3), BigInteger(4), BigInteger(48)},
+      {"shl negative", CSBIGINTEGERD_SHL, BigInteger(3), BigInteger(-1),
+       error},
+      {"shl 2^40", CSBIGINTEGERD_SHL, BigInteger(1),
+       BigInteger::Pow(BigInteger(2), 40), error},
+      {"shl zero 2^31", CSBIGINTEGERD_SHL, BigInteger(0),
+       BigInteger::Pow(BigInteger(2), 31), error},
+      {"shr", CSBIGINTEGERD_SHR, BigInteger(1024), BigInteger(3),
+       BigInteger(128)},
+      {"shr floor", CSBIGINTEGERD_SHR, BigInteger(-9), BigInteger(3),
+       BigInteger(-2)},
+      {"shr bit length", CSBIGINTEGERD_SHR, BigInteger(-8), BigInteger(3),
+       BigInteger(-1)},
+      {"shr 2^32+1", CSBIGINTEGERD_SHR, BigInteger(7), big, BigInteger(0)},
+      {"shr 2^32+1 negative", CSBIGINTEGERD_SHR, BigInteger(-7), big,
+       BigInteger(-1)},
+      {"shr 2^64", CSBIGINTEGERD_SHR, BigInteger(7), huge, error},
+      {"shr negative", CSBIGINTEGERD_SHR, BigInteger(7), BigInteger(-1),
+       error},
+      {"shr negative 2^32+1", CSBIGINTEGERD_SHR, BigInteger(7), -big, error},
+      {"pow 256^2^30", CSBIGINTEGERD_POW, BigInteger(256),
+       BigInteger(1 << 30), error},
+  };
+  size_t failed = 0;
+  std::vector<cs_byte> vr(64);
+  for (const Case& c : cases) {
+    cs_vbyte a = c.a.ToByteArray(), b = c.b.ToByteArray();
+    std::vector<cs_byte> vb(a.begin(), a.end());
+    vb.insert(vb.end(), b.begin(), b.end());
+    cs_int32 sizes[2] = {static_cast<cs_int32>(a.size()),
+                         static_cast<cs_int32>(b.size())};
+    cs_int32 sz = csbigintegerd_call(fd, c.op, vb.data(), sizes, 2, vr.data(),
+                                     static_cast<int>(vr.size()));
+    bool ok = c.expected.IsError()
+                  ? (sz == 0)
+                  : ((sz > 0) && (BigInteger(cs_vbyte(vr.begin(),
+                                                      vr.begin() + sz)) ==
+                                  c.expected));
+    if (!ok) {
+      std::printf("csbigintegerd_test: FAILED %s (reply size %d)\n", c.name,
+                  sz);
+      failed++;
+    }
+  }
+  csbigintegerd_close(fd);
+  std::printf("csbigintegerd_test: %zu of %zu cases passed\n",
+              cases.size() - failed, cases.size());
+  return (failed == 0) ? 0 : 1;
+}
@@ -12,7 +12,10 @@
 #include <gmpxx.h>
 
 // c++
-#include <iostream>  // TODO(igormcoelho): remove
+#include <cstring>    // memcmp
+#include <iostream>   // TODO(igormcoelho): remove
+#include <stdexcept>  // invalid_argument
+#include <vector>
 
 // Ported from
 // -
@@ -21,79 +24,293 @@
 // using namespace std;
 using namespace csbiginteger;  // NOLINT
 
-// input is raw little-endian format
-mpz_class csBigIntegerMPZparse(cs_vbyte n);
+// input is raw big-endian two's complement format (internal BigInteger data)
+void csBigIntegerMPZparse(const cs_byte* data, size_t n, mpz_ptr out);
 
-// string parse
-mpz_class csBigIntegerMPZparses(std::string n, int base);
-
-// get bitstring from mpz bignum non-negative object
-std::string csBigIntegerGetBitsFromNonNegativeMPZ(mpz_class big);
+// string parse (base 10) into 'out' (throws std::invalid_argument, as
+// mpz_class does)
+void csBigIntegerMPZparses(const std::string& n, mpz_ptr out);
 
 // get big-endian bytearray from mpz bignum (positive or negative)
-cs_vbyte csBigIntegerGetBytesFromMPZ(mpz_class big);
+template <class VByte>
+void csBigIntegerGetBytesFromMPZ(mpz_srcptr big, VByte& out);
+
+// ================ thread-local scratch pool ===================
+// Every engine operation borrows preinitialized mpz_t slots (and byte/char
+// buffers) from the calling thread, so steady-state operations do not call
+// malloc/free. Slots are grouped by operand size class, so one huge
+// operation does not force small ones to walk over oversized buffers.
+class MPZScratchPool {
+ public:
+  static const int NUM_CLASSES = 3;
+  static const int NUM_SLOTS = 3;  // two operands and one result
+
+  MPZScratchPool() {
+    for (int c = 0; c < NUM_CLASSES; c++)
+      for (int i = 0; i < NUM_SLOTS; i++) mpz_init2(slots[c][i], classBits(c));
+  }
+
+  ~MPZScratchPool() {
+    for (int c = 0; c < NUM_CLASSES; c++)
+      for (int i = 0; i < NUM_SLOTS; i++) mpz_clear(slots[c][i]);
+  }
+
+  MPZScratchPool(const MPZScratchPool&) = delete;
+  MPZScratchPool& operator=(const MPZScratchPool&) = delete;
+
+  // initial capacity (in bits) for each size class
+  static mp_bitcnt_t classBits(int sizeClass) {
+    return sizeClass == 0 ? 128 : (sizeClass == 1 ? 4096 : 65536);
+  }
+
+  // size class for operands with 'nbytes' (largest operand)
+  static int sizeClass(size_t nbytes) {
+    return nbytes <= 16 ? 0 : (nbytes <= 512 ? 1 : 2);
+  }
+
+  mpz_ptr slot(int sizeClass, int i) { return slots[sizeClass][i]; }
+
+  // large slots give back memory above 16x its initial capacity
+  void release(int sizeClass) {
+    if (sizeClass != NUM_CLASSES - 1) return;
+    for (int i = 0; i < NUM_SLOTS; i++)
+      if (static_cast<mp_bitcnt_t>(slots[sizeClass][i]->_mp_alloc) *
+              GMP_NUMB_BITS >
+          16 * classBits(sizeClass))
+        mpz_realloc2(slots[sizeClass][i], classBits(sizeClass));
+  }
+
+  cs_vbyte bytes;  // magnitude buffer (byte conversions)
+
+ private:
+  mpz_t slots[NUM_CLASSES][NUM_SLOTS];
+};
+
+static MPZScratchPool& csBigIntegerMPZpool() {
+  static thread_local MPZScratchPool pool;
+  return pool;
+}
+
+// ================ thread-local operand cache ===================
+// Recent operands (raw big-endian two's complement bytes) are kept as
+// prebuilt mpz_t, so repeated ones (constants, a modulus, 10^decimals) skip
+// magnitude conversion and mpz_import. Lookups hash the bytes (8 at a time)
+// and confirm with memcmp. An operand is admitted on its second miss within
+// a short window (tracked by hash only), so streams of unique operands do
+// not pay for copies into the cache. Build with -DCSBIGINTEGER_NO_MPZ_CACHE
+// to disable it.
+class MPZOperandCache {
+ public:
+  static const int NUM_ENTRIES = 16;
+  static const int NUM_SEEN = 64;        // admission window (hashes)
+  static const size_t MIN_BYTES = 16;    // smaller ones parse faster
+  static const size_t MAX_BYTES = 4096;  // larger ones are not kept
+
+  MPZOperandCache() {
+    for (int i = 0; i < NUM_ENTRIES; i++) mpz_init(entries[i].value);
+  }
+
+  ~MPZOperandCache() {
+    for (int i = 0; i < NUM_ENTRIES; i++) mpz_clear(entries[i].value);
+  }
+
+  MPZOperandCache(const MPZOperandCache&) = delete;
+  MPZOperandCache& operator=(const MPZOperandCache&) = delete;
+
+  static cs_uint64 hash(const cs_byte* data, size_t n) {
+    cs_uint64 h = 0x9e3779b97f4a7c15ull ^ n;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+      cs_uint64 w;
+      std::memcpy(&w, data + i, 8);
+      h = (h ^ w) * 0xff51afd7ed558ccdull;
+      h ^= h >> 32;
+    }
+    for (; i < n; i++) h = (h ^ data[i]) * 0x100000001b3ull;
+    return h ^ (h >> 29);
+  }
+
+  // cached value of operand (most recent from now on), nullptr on miss
+  mpz_srcptr find(const cs_byte* data, size_t n, cs_uint64 h) {
+    for (int i = 0; i < NUM_ENTRIES; i++) {
+      Entry& e = entries[i];
+      if ((e.hash == h) && (e.bytes.size() == n) &&
+          (std::memcmp(e.bytes.data(), data, n) == 0)) {
+        e.stamp = ++clock;
+        hits++;
+        return e.value;
+      }
+    }
+    misses++;
+    return nullptr;
+  }
+
+  // keeps parsed operand when seen recently (replaces least recent entry,
+  // never the one just found)
+  void admit(const cs_byte* data, size_t n, cs_uint64 h, mpz_srcptr value) {
+    cs_uint64& s = seen[h % NUM_SEEN];
+    if (s != h) {
+      s = h;
+      return;
+    }
+    Entry* victim = &entries[0];
+    for (int i = 1; i < NUM_ENTRIES; i++)
+      if (entries[i].stamp < victim->stamp) victim = &entries[i];
+    victim->hash = h;
+    victim->bytes.assign(data, data + n);
+    victim->stamp = ++clock;
+    mpz_set(victim->value, value);
+  }
+
+  cs_uint64 hits{0};
+  cs_uint64 misses{0};
+
+ private:
+  struct Entry {
+    cs_uint64 hash{0};
+    cs_uint64 stamp{0};  // last use (0 is free)
+    cs_vbyte bytes;
+    mpz_t value;
+  };
+
+  Entry entries[NUM_ENTRIES];
+  cs_uint64 seen[NUM_SEEN] = {};
+  cs_uint64 clock{0};
+};
+
+static MPZOperandCache& csBigIntegerMPZcache() {
+  static thread_local MPZOperandCache cache;
+  return cache;
+}
+
+// read-only operand: cached mpz_t, or parsed into 'slot'. the cached one is
+// the most recent entry, so it survives the next admission (the other
+// operand of a binary operation)
+static mpz_srcptr csBigIntegerMPZoperand(const cs_byte* data, size_t n,
+                                         mpz_ptr slot) {
+#ifndef CSBIGINTEGER_NO_MPZ_CACHE
+  if ((n >= MPZOperandCache::MIN_BYTES) && (n <= MPZOperandCache::MAX_BYTES)) {
+    MPZOperandCache& cache = csBigIntegerMPZcache();
+    cs_uint64 h = MPZOperandCache::hash(data, n);
+    mpz_srcptr cached = cache.find(data, n, h);
+    if (cached != nullptr) return cached;
+    csBigIntegerMPZparse(data, n, slot);
+    cache.admit(data, n, h, slot);
+    return slot;
+  }
+#endif
+  csBigIntegerMPZparse(data, n, slot);
+  return slot;
+}
 
 // ==================== END MPZ =======================
 
 std::string BigInteger::getEngine() { return "GMP"; }
 
+bool BigInteger::OperandCacheStats(cs_uint64& hits, cs_uint64& misses) {
+#ifdef CSBIGINTEGER_NO_MPZ_CACHE
+  hits = misses = 0;
+  return false;
+#else
+  MPZOperandCache& cache = csBigIntegerMPZcache();
+  hits = cache.hits;
+  misses = cache.misses;
+  return true;
+#endif
+}
+
 const BigInteger BigInteger::error() {
   BigInteger big;
-  big._data = cs_vbyte(0);  // empty array is error
+  big._data.clear();  // empty array is error
   return big;
 }
 
 BigInteger BigInteger::Pow(BigInteger value, int exponent) {
   // according to C# spec, only non-negative int32 values accepted here
   if (exponent < 0) return BigInteger::Error();
-  mpz_class big1 = csBigIntegerMPZparse(value.ToByteArray());
-  mpz_class r;
+  // polled (progress and cancellation)
+  if (BigIntegerContext::Current() != nullptr)
+    return powPolled(value, exponent);
+  MPZScratchPool& pool = csBigIntegerMPZpool();
+  int c = MPZScratchPool::sizeClass(value._data.size() * exponent);
+  mpz_srcptr v = csBigIntegerMPZoperand(value._data.data(), value._data.size(),
+                                        pool.slot(c, 0));
   uint64_t _exp = exponent;
-  mpz_pow_ui(r.get_mpz_t(), big1.get_mpz_t(), _exp);
-  cs_vbyte vr = csBigIntegerGetBytesFromMPZ(r);
-  reverse(vr.begin(), vr.end());  // to little-endian
-  return BigInteger(vr);
+  mpz_pow_ui(pool.slot(c, 2), v, _exp);
+  BigInteger r;  // result
+  csBigIntegerGetBytesFromMPZ(pool.slot(c, 2), r._data);
+  pool.release(c);
+  return r;
 }
 
 // default is base 10
 // allows base 2
 // if base 16, prefix '0x' indicates big-endian, otherwise is little-endian
 BigInteger::BigInteger(std::string str, int base) {
-  mpz_class a = csBigIntegerMPZparses(str, base);
-  _data = csBigIntegerGetBytesFromMPZ(a);
-}
+  MPZScratchPool& pool = csBigIntegerMPZpool();
+  if (base == 10) {
+    // short plain decimal (optional '-') goes through shared SWAR parser
+    // (mpz_set_str is faster on long inputs)
+    if (str.length() <= 512) {
+      std::from_chars_result r = FromChars(str, *this, 10);
+      if ((r.ec == std::errc()) && (r.ptr == str.data() + str.size())) return;
+    }
+    int c = MPZScratchPool::sizeClass(str.length() / 2);
+    csBigIntegerMPZparses(str, pool.slot(c, 0));
+    csBigIntegerGetBytesFromMPZ(pool.slot(c, 0), _data);
+    pool.release(c);
+    return;
+  }
 
-BigInteger::BigInteger(float val) {
-  mpz_class a = val;
+  // zero padding
+  while (str.length() < 2) str.insert(0, "0");
 
-  _data = csBigIntegerGetBytesFromMPZ(a);
+  // prefix '0x' optional. input always big-endian
+  if ((str[0] == '0') && (str[1] == 'x')) str = str.substr(2, str.length() - 2);
+  cs_vbyte vb = Helper::HexToBytes(str);  // two's complement big-endian
+
+  // compress (through magnitude)
+  bool negative = Helper::toMagnitude(vb.data(), vb.size(), pool.bytes);
+  Helper::fromMagnitude(pool.bytes.data(), pool.bytes.size(), negative, _data);
 }
 
 cs_int32 BigInteger::toInt() const {
-  cs_vbyte vb = this->ToByteArray();  // little-endian
-  mpz_class a = csBigIntegerMPZparse(vb);
-  cs_int32 i = a.get_ui();  // unsigned int
-  if (a < 0) i *= -1;
+  cs_int64 v;
+  if (TryToInt64(v) && (v == static_cast<cs_int32>(v)))
+    return static_cast<cs_int32>(v);  // fits (no engine call)
+  mpz_ptr a =
+      csBigIntegerMPZpool().slot(MPZScratchPool::sizeClass(Length()), 0);
+  csBigIntegerMPZparse(_data.data(), _data.size(), a);
+  cs_int32 i = mpz_get_ui(a);  // unsigned int
+  if (mpz_sgn(a) < 0) i *= -1;
   return i;
 }
 
 cs_int64 BigInteger::toLong() const {
-  cs_vbyte vb = this->ToByteArray();  // little-endian
-  mpz_class a = csBigIntegerMPZparse(vb);
-  cs_int64 i = a.get_si();  // signed long int
+  cs_int64 v;
+  if (TryToInt64(v)) return v;  // fits (no engine call)
+  mpz_ptr a =
+      csBigIntegerMPZpool().slot(MPZScratchPool::sizeClass(Length()), 0);
+  csBigIntegerMPZparse(_data.data(), _data.size(), a);
+  cs_int64 i = mpz_get_si(a);  // signed long int
   return i;
 }
 
+// compare two BigInteger using scratch slots
+static int csBigIntegerMPZcmp(const cs_byte* d1, size_t n1, const cs_byte* d2,
+                              size_t n2) {
+  MPZScratchPool& pool = csBigIntegerMPZpool();
+  int c = MPZScratchPool::sizeClass(std::max(n1, n2));
+  mpz_srcptr a = csBigIntegerMPZoperand(d1, n1, pool.slot(c, 0));
+  mpz_srcptr b = csBigIntegerMPZoperand(d2, n2, pool.slot(c, 1));
+  return mpz_cmp(a, b);
+}
+
 bool BigInteger::operator>(const BigInteger& big2) const {
   if (this->IsError() || big2.IsError()) return false;
 
-  mpz_class bThis =
-      csBigIntegerMPZparse(this->ToByteArray());  // parse from little-endian
-  mpz_class bOther =
-      csBigIntegerMPZparse(big2.ToByteArray());  // parse from little-endian
-
-  bool r = (bThis > bOther);  // result
-  return r;
+  return csBigIntegerMPZcmp(_data.data(), _data.size(), big2._data.data(),
+                            big2._data.size()) > 0;
 }
 
 bool BigInteger::operator<(const BigInteger& big2) const {
@@ -101,73 +318,73 @@ bool BigInteger::operator<(const BigInteger& big2) const {
     return false;
   }
 
-  mpz_class bThis =
-      csBigIntegerMPZparse(this->ToByteArray());  // parse from little-endian
-  mpz_class bOther =
-      csBigIntegerMPZparse(big2.ToByteArray());  // parse from little-endian
-
-  bool r = (bThis < bOther);  // result
-  return r;
+  return csBigIntegerMPZcmp(_data.data(), _data.size(), big2._data.data(),
+                            big2._data.size()) < 0;
 }
 
 // ----------------- arithmetic ---------------------
 
+// parse both operands into scratch slots, apply 'op' and store result bytes
+// (big-endian) into 'r'
+template <class MPZOp, class VByte>
+static void csBigIntegerMPZapply(const cs_byte* d1, size_t n1,
+                                 const cs_byte* d2, size_t n2, MPZOp op,
+                                 VByte& r) {
+  MPZScratchPool& pool = csBigIntegerMPZpool();
+  int c = MPZScratchPool::sizeClass(std::max(n1, n2));
+  mpz_ptr x = pool.slot(c, 2);
+  mpz_srcptr a = csBigIntegerMPZoperand(d1, n1, pool.slot(c, 0));
+  mpz_srcptr b = csBigIntegerMPZoperand(d2, n2, pool.slot(c, 1));
+  op(x, a, b);
+  csBigIntegerGetBytesFromMPZ(x, r);  // get big-endian
+  pool.release(c);
+}
+
 BigInteger BigInteger::operator+(const BigInteger& big2) const {
   if (this->IsError() || big2.IsError()) return Error();
 
-  mpz_class bThis =
-      csBigIntegerMPZparse(this->ToByteArray());  // parse from little-endian
-  mpz_class bOther =
-      csBigIntegerMPZparse(big2.ToByteArray());  // parse from little-endian
-  BigInteger r;                                  // result
-  r._data = csBigIntegerGetBytesFromMPZ(bThis + bOther);  // get big-endian
+  BigInteger r;  // result
+  csBigIntegerMPZapply(_data.data(), _data.size(), big2._data.data(),
+                       big2._data.size(), mpz_add, r._data);
   return r;
 }
 
 BigInteger BigInteger::operator-(const BigInteger& big2) const {
   if (this->IsError() || big2.IsError()) return Error();
 
-  mpz_class bThis =
-      csBigIntegerMPZparse(this->ToByteArray());  // parse from little-endian
-  mpz_class bOther =
-      csBigIntegerMPZparse(big2.ToByteArray());  // parse from little-endian
-  BigInteger r;                                  // result
-  r._data = csBigIntegerGetBytesFromMPZ(bThis - bOther);  // get big-endian
+  BigInteger r;  // result
+  csBigIntegerMPZapply(_data.data(), _data.size(), big2._data.data(),
+                       big2._data.size(), mpz_sub, r._data);
   return r;
 }
 
 BigInteger BigInteger::operator*(const BigInteger& big2) const {
   if (this->IsError() || big2.IsError()) return Error();
+  if (polled(*this, big2)) return mulPolled(*this, big2);  // cancellable
 
-  mpz_class bThis =
-      csBigIntegerMPZparse(this->ToByteArray());  // parse from little-endian
-  mpz_class bOther =
-      csBigIntegerMPZparse(big2.ToByteArray());  // parse from little-endian
-  BigInteger r;                                  // result
-  r._data = csBigIntegerGetBytesFromMPZ(bThis * bOther);  // get big-endian
+  BigInteger r;  // result
+  csBigIntegerMPZapply(_data.data(), _data.size(), big2._data.data(),
+                       big2._data.size(), mpz_mul, r._data);
   return r;
 }
 
 BigInteger BigInteger::operator/(const BigInteger& big2) const {
   if (this->IsError() || big2.IsError() || big2.IsZero()) return Error();
-  mpz_class bThis =
-      csBigIntegerMPZparse(this->ToByteArray());  // parse from little-endian
-  mpz_class bOther =
-      csBigIntegerMPZparse(big2.ToByteArray());  // parse from little-endian
-  BigInteger r;                                  // result
-  r._data = csBigIntegerGetBytesFromMPZ(bThis / bOther);  // get big-endian
+  if (polled(*this, big2)) return divPolled(*this, big2, false);
+
+  BigInteger r;  // result (truncated, as C#)
+  csBigIntegerMPZapply(_data.data(), _data.size(), big2._data.data(),
+                       big2._data.size(), mpz_tdiv_q, r._data);
   return r;
 }
 
 BigInteger BigInteger::operator%(const BigInteger& big2) const {
   if (this->IsError() || big2.IsError() || big2.IsZero()) return Error();
+  if (polled(*this, big2)) return divPolled(*this, big2, true);
 
-  mpz_class bThis =
-      csBigIntegerMPZparse(this->ToByteArray());  // parse from little-endian
-  mpz_class bOther =
-      csBigIntegerMPZparse(big2.ToByteArray());  // parse from little-endian
-  BigInteger r;                                  // result
-  r._data = csBigIntegerGetBytesFromMPZ(bThis % bOther);  // get big-endian
+  BigInteger r;  // result (sign of dividend, as C#)
+  csBigIntegerMPZapply(_data.data(), _data.size(), big2._data.data(),
+                       big2._data.size(), mpz_tdiv_r, r._data);
   return r;
 }
 
@@ -175,11 +392,15 @@ BigInteger BigInteger::operator<<(const BigInteger& big2) const {
   if (this->IsError() || big2.IsError()) return Error();
   if (big2 < Zero()) return (*this) >> -big2;
 
-  mpz_class bThis =
-      csBigIntegerMPZparse(this->ToByteArray());  // parse from little-endian
-  BigInteger r;                                   // result
-  r._data =
-      csBigIntegerGetBytesFromMPZ(bThis << big2.toInt());  // get big-endian
+  mp_bitcnt_t shift = big2.toInt();  // before borrowing scratch slots
+  MPZScratchPool& pool = csBigIntegerMPZpool();
+  int c = MPZScratchPool::sizeClass(Length() + shift / 8);
+  mpz_srcptr a =
+      csBigIntegerMPZoperand(_data.data(), _data.size(), pool.slot(c, 0));
+  mpz_mul_2exp(pool.slot(c, 2), a, shift);
+  BigInteger r;  // result
+  csBigIntegerGetBytesFromMPZ(pool.slot(c, 2), r._data);  // get big-endian
+  pool.release(c);
   return r;
 }
 
@@ -187,143 +408,43 @@ BigInteger BigInteger::operator>>(const BigInteger& big2) const {
   if (this->IsError() || big2.IsError()) return Error();
   if (big2 < Zero()) return (*this) << -big2;
 
-  mpz_class bThis =
-      csBigIntegerMPZparse(this->ToByteArray());  // parse from little-endian
-  BigInteger r;                                   // result
-  r._data =
-      csBigIntegerGetBytesFromMPZ(bThis >> big2.toInt());  // get big-endian
+  mp_bitcnt_t shift = big2.toInt();  // before borrowing scratch slots
+  MPZScratchPool& pool = csBigIntegerMPZpool();
+  int c = MPZScratchPool::sizeClass(Length());
+  mpz_srcptr a =
+      csBigIntegerMPZoperand(_data.data(), _data.size(), pool.slot(c, 0));
+  // floor, as arithmetic shift on two's complement
+  mpz_fdiv_q_2exp(pool.slot(c, 2), a, shift);
+  BigInteger r;  // result
+  csBigIntegerGetBytesFromMPZ(pool.slot(c, 2), r._data);  // get big-endian
+  pool.release(c);
   return r;
 }
 
 // =================== BEGIN MPZ AGAIN =======================
 
 std::string BigInteger::toStringBase10() const {
-  mpz_class bThis =
-      csBigIntegerMPZparse(this->ToByteArray());  // parse from little-endian
-  return bThis.get_str(10);
+  MPZScratchPool& pool = csBigIntegerMPZpool();
+  int c = MPZScratchPool::sizeClass(Length());
+  mpz_srcptr bThis =
+      csBigIntegerMPZoperand(_data.data(), _data.size(), pool.slot(c, 0));
+  // written in place (sizeinbase may be one more than needed)
+  std::string s(mpz_sizeinbase(bThis, 10) + 2, '\0');  // sign and '\0'
+  mpz_get_str(s.data(), 10, bThis);
+  s.resize(std::char_traits<char>::length(s.data()));
+  pool.release(c);
+  return s;
 }
 
-// assumes big >= 0
-std::string csBigIntegerGetBitsFromNonNegativeMPZ(mpz_class big) {
-  std::string sbin;
-  while (big > 0) {
-    mpz_class rest = (big % 2);
-    sbin.insert(0, (rest.get_ui() == 0 ? std::string("0") : std::string("1")));
-    big = big / 2;
-  }
-  return sbin;
-}
-
-cs_vbyte csBigIntegerGetBytesFromMPZ(mpz_class big) {
-  // check if positive or negative
-  if (big >= 0) {
-    // -------------------
-    // positive conversion
-    // -------------------
-    cs_vbyte v;
-    while (big > 0) {
-      mpz_class rest = (big % 256);
-      v.push_back((cs_byte)rest.get_ui());
-      big = big / 256;
-    }
-
-    // added in little-endian format (backwards)
-    std::string leHex = Helper::toHexString(v);
-    if (leHex.length() == 0) leHex = "00";
-    // check if became negative
-    if (Helper::checkNegativeBit(leHex)) {
-      v.push_back(0);  // guarantee non-negative
-    }
-
-    // v is added backwards (little-endian), must reverse (to big-endian)
-    reverse(v.begin(), v.end());
-    if (v.size() == 0) v.push_back(0x00);
-    // finished
-    return v;
-  } else {
-    // -------------------
-    // negative conversion
-    // -------------------
-    // turn into positive
-    mpz_class x = big * (-1);
-    // cout << "x positive " << x << endl;
-
-    // ========================
-    // perform two's complement
-    // ========================
-    // convert to binary
-    cs_vbyte vx =
-        csBigIntegerGetBytesFromMPZ(x);  // positive is easy to convert
-    // cout << Helper::toHexString(vx) << endl;
-    mpz_class bx(Helper::toHexString(vx), 16);
-    // get binary representation
-    std::string y = bx.get_str(2);
-    // cout << "numbits: " << y.length() << endl;
-    // cout << "ybits: " << y << endl;
-    // cout << "dbits: " << csBigIntegerGetBitsFromNonNegativeMPZ(x) << endl;
-
-    // extra padding for limit cases (avoid overflow)
-    y.insert(0, "0");  // prepend
-
-    // guarantee length must be at least 8, or add padding!
-    while ((y.length() < 8) || (y.length() % 8 != 0)) {
-      y.insert(0, "0");  // prepend
-    }
-
-    // invert bits
-    std::string y2 = "";
-    for (int i = 0; i < (int)y.length(); i++) y2 += (y[i] == '0' ? '1' : '0');
-    // cout << "rbits: " << y2 << endl;
-
-    // go back to bigint
-    // BigInteger by3(y2, 2); // recursive behavior
-    mpz_class by3(y2, 2);
-    // sum 1
-    mpz_class bby3 = by3 + 1;
-
-    // cout << "(~y)+1: " << bby3 << endl;
-
-    // convert to binary again
-    std::string y4 = csBigIntegerGetBitsFromNonNegativeMPZ(bby3);
-    // cout << "y4bits: " << y4 << endl;
-
-    // padding
-    while ((y4.length() < 8) || (y4.length() % 8 != 0)) {
-      y4.insert(0, "0");  // prepend
-    }
-
-    // cout << "y4bits: " << y4 << endl;
-
-    // get in bytes
-    cs_vbyte v = Helper::BinToBytes(y4);
-
-    // cout << "v: " << Helper::toHexString(v) << endl;
-
-    // convert to little-endian
-    reverse(v.begin(), v.end());  // to little-endian
-
-    // will add extra ff to guarantee its negative, and simplify later (remove
-    // extra ff)
-    v.push_back(0xff);
-
-    cs_vbyte vsimple = v;
-    while ((vsimple.size() > 1) &&
-           (vsimple.at(((int)vsimple.size()) - 1) == 0xff)) {
-      vsimple.pop_back();
-      std::string lehex = Helper::toHexString(vsimple);
-      if (Helper::checkNegativeBit(lehex)) {
-        // still negative! can keep removal
-        v = vsimple;
-      } else
-        break;
-    }
-
-    // convert to big-endian
-    reverse(v.begin(), v.end());  // to big-endian
-
-    // finished
-    return v;
-  }
+template <class VByte>
+void csBigIntegerGetBytesFromMPZ(mpz_srcptr big, VByte& out) {
+  // export magnitude (big-endian) into scratch buffer
+  cs_vbyte& mag = csBigIntegerMPZpool().bytes;
+  mag.resize((mpz_sizeinbase(big, 2) + 7) / 8);
+  size_t count = 0;
+  mpz_export(mag.data(), &count, 1, 1, 1, 0, big);
+  // two's complement (most compressed format)
+  Helper::fromMagnitude(mag.data(), count, mpz_sgn(big) < 0, out);
 }
 
 // taken from csBigInteger.js
@@ -345,78 +466,17 @@ cs_vbyte csBigIntegerGetBytesFromMPZ(mpz_class big) {
                 a <BigInteger> instance.
 */
 
-// expects vbyte on little-endian format (raw internal format)
-mpz_class csBigIntegerMPZparse(cs_vbyte n) {
-  // if (n.size() == 0)
-  //    return mpz_class(0); // never invoked
-
-  std::string s = Helper::toHexString(n);
-
-  // verify if number is negative (most significant bit)
-  if (Helper::checkNegativeBit(s)) {
-    // is negative, must handle twos-complement
-    mpz_class vint(Helper::revertHexString(s), 16);  // as big-endian again
-    // get bitstring
-    std::string rbitnum = csBigIntegerGetBitsFromNonNegativeMPZ(vint);
-    // negate bits
-    std::stringstream y2;
-    for (int i = 0; i < (int)rbitnum.length(); i++)
-      y2 << (rbitnum[i] == '0' ? '1' : '0');
-    // to bigint again
-    mpz_class by2(y2.str(), 2);
-    // add one
-    mpz_class by2add = by2 + 1;
-    // get negative
-    mpz_class finalnum = by2add * (-1);
-    // ensure it's negative (TODO(igormcoelho): remove)
-    assert(finalnum < 0);  // must be negative
-    // finished
-    return finalnum;
-  } else {
-    // positive is easy (in little-endian format)
-    std::string sbig = Helper::revertHexString(s);
-    // build bignum in big-endian
-    return mpz_class(sbig, 16);  // big-endian again
-  }
+// expects big-endian two's complement bytes (raw internal format)
+void csBigIntegerMPZparse(const cs_byte* data, size_t n, mpz_ptr out) {
+  cs_vbyte& mag = csBigIntegerMPZpool().bytes;
+  // verify if number is negative (most significant bit), and get magnitude
+  bool negative = Helper::toMagnitude(data, n, mag);
+  mpz_import(out, mag.size(), 1, 1, 1, 0, mag.data());
+  if (negative) mpz_neg(out, out);
 }
 
-mpz_class csBigIntegerMPZparses(std::string n, int base) {
-  if (base == 10) {
-    // if (n.length() == 0)
-    //    n = "0"; // not necessary
-    return mpz_class(n, base);
-  }
-
-  // never used! internal function only
-  // if (base == 2) {
-  //   if (n.length() == 0)
-  //      n = "0";
-  //   return mpz_class(n, base);
-  //}
-
-  // never used! internal function only
-  // if (base != 16) {
-  //   cout << "UNSUPPORTED BASE! " << base << endl;
-  //   exit(1);
-  //}
-
-  // zero padding
-  while (n.length() < 2) n.insert(0, "0");
-
-  // return bytearray initialized
-  cs_vbyte vb;
-  // prefix '0x' optional. input always big-endian
-  if ((n[0] == '0') && (n[1] == 'x')) {
-    // removing '0x'
-    n = n.substr(2, n.length() - 2);
-    vb = Helper::HexToBytes(n);
-
-  } else {
-    vb = Helper::HexToBytes(n);  // directly reading big-endian byte array
-  }
-
-  reverse(vb.begin(), vb.end());  // to little-endian
-
-  // base 16
-  return csBigIntegerMPZparse(vb);  // vb is little-endian byte array
+void csBigIntegerMPZparses(const std::string& n, mpz_ptr out) {
+  // same behavior as mpz_class(n, 10)
+  if (mpz_set_str(out, n.c_str(), 10) != 0)
+    throw std::invalid_argument("mpz_set_str");
 }
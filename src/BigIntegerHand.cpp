@@ -13,38 +13,60 @@
 // using namespace std;
 using namespace csbiginteger;  // NOLINT
 
-// input is raw little-endian format
-HandBigInt csBigIntegerHANDparse(cs_vbyte n);
-
-// string parse
-HandBigInt csBigIntegerHANDparses(std::string n, int base);
-
-// get bitstring from mpz bignum non-negative object
-std::string csBigIntegerGetBitsFromNonNegativeHAND(HandBigInt big);
-
-// get big-endian bytearray from mpz bignum (positive or negative)
-cs_vbyte csBigIntegerGetBytesFromHAND(HandBigInt big);
+// input is raw big-endian two's complement format (internal BigInteger data)
+HandBigInt csBigIntegerHANDparse(const cs_byte* data, size_t n);
+
+// string parse (base 10)
+HandBigInt csBigIntegerHANDparses(const std::string& n);
+
+// get big-endian bytearray from HandBigInt (positive or negative)
+template <class VByte>
+void csBigIntegerGetBytesFromHAND(const HandBigInt& big, VByte& out);
+
+// ================ thread-local scratch pool ===================
+// Buffers reused by byte/decimal conversions of the calling thread, so they
+// do not allocate in steady state (HandBigInt arithmetic works in place on
+// its own per-thread strings, see HandScratch).
+class HANDScratchPool {
+ public:
+  cs_vbyte bytes;               // magnitude buffer
+  std::vector<uint32_t> limbs;  // base 10^9 or base 2^32 digits
+};
+
+static HANDScratchPool& csBigIntegerHANDpool() {
+  static thread_local HANDScratchPool pool;
+  return pool;
+}
 
 // ==================== END MPZ =======================
 
 std::string BigInteger::getEngine() { return "HandBigInt"; }
 
+bool BigInteger::OperandCacheStats(cs_uint64& hits, cs_uint64& misses) {
+  hits = misses = 0;
+  return false;  // no operand cache
+}
+
 const BigInteger BigInteger::error() {
   BigInteger big;
-  big._data = cs_vbyte(0);  // empty array is error
+  big._data.clear();  // empty array is error
   return big;
 }
 
 BigInteger BigInteger::Pow(BigInteger value, int exponent) {
   // according to C# spec, only non-negative int32 values accepted here
   if (exponent < 0) return BigInteger::Error();
-  HandBigInt big1 = csBigIntegerHANDparse(value.ToByteArray());
+  // polled (progress and cancellation)
+  if (BigIntegerContext::Current() != nullptr)
+    return powPolled(value, exponent);
+  HandBigInt big1 =
+      csBigIntegerHANDparse(value._data.data(), value._data.size());
   HandBigInt r;
   unsigned long _exp = exponent;
   r = HandBigInt::pow(big1, _exp);
-  cs_vbyte vr = csBigIntegerGetBytesFromHAND(r);
-  reverse(vr.begin(), vr.end());  // to little-endian
-  return BigInteger(vr);
+  BigInteger big;  // result
+  csBigIntegerGetBytesFromHAND(r, big._data);
+  return big;
 }
 
 // default is base 10
@@ -54,30 +76,34 @@ BigInteger::BigInteger(std::string str, int base) {
   // std::cerr << "======= BigInteger(str='" << str << "' base=" << base << ")
   // =======" << std::endl;
   //
-  HandBigInt a = csBigIntegerHANDparses(str, base);
-  // std::cout << "big: '" << a << "'" << std::endl;
-  _data = csBigIntegerGetBytesFromHAND(a);
-  // std::cout << "_data: " << Helper::toHexString(_data) << std::endl;
-  //  ======== DEBUG CHECK
-  /*
-  if((base == 10) && (str != "-0")) {
-     std::string check = this->ToString(10);
-     std::cout << "ToString(): " << this->ToString() << std::endl;
-     std::cout << "ToString(10): " << this->ToString(10) << std::endl;
-     assert(str == check);
+  if (base == 10) {
+    // plain decimal (optional '-') goes through shared SWAR parser
+    std::from_chars_result r = FromChars(str, *this, 10);
+    if ((r.ec == std::errc()) && (r.ptr == str.data() + str.size())) return;
+    HandBigInt a = csBigIntegerHANDparses(str);
+    // std::cout << "big: '" << a << "'" << std::endl;
+    csBigIntegerGetBytesFromHAND(a, _data);
+    return;
   }
-  */
-}
 
-BigInteger::BigInteger(float val) {
-  HandBigInt a = val;
+  // zero padding
+  while (str.length() < 2) str.insert(0, "0");
 
-  _data = csBigIntegerGetBytesFromHAND(a);
+  // prefix '0x' optional. input always big-endian
+  if ((str[0] == '0') && (str[1] == 'x')) str = str.substr(2, str.length() - 2);
+  cs_vbyte vb = Helper::HexToBytes(str);  // two's complement big-endian
+
+  // compress (through magnitude)
+  cs_vbyte& mag = csBigIntegerHANDpool().bytes;
+  bool negative = Helper::toMagnitude(vb.data(), vb.size(), mag);
+  Helper::fromMagnitude(mag.data(), mag.size(), negative, _data);
 }
 
 cs_int32 BigInteger::toInt() const {
-  cs_vbyte vb = this->ToByteArray();  // little-endian
-  HandBigInt a = csBigIntegerHANDparse(vb);
+  cs_int64 v;
+  if (TryToInt64(v) && (v == static_cast<cs_int32>(v)))
+    return static_cast<cs_int32>(v);  // fits (no engine call)
+  HandBigInt a = csBigIntegerHANDparse(_data.data(), _data.size());
   // std::cout << "toInt a=" << a.toString() << std::endl;
   cs_int32 i = a.get_ui();  // unsigned int
   if (a < 0) i *= -1;
@@ -85,8 +111,9 @@ cs_int32 BigInteger::toInt() const {
 }
 
 cs_int64 BigInteger::toLong() const {
-  cs_vbyte vb = this->ToByteArray();  // little-endian
-  HandBigInt a = csBigIntegerHANDparse(vb);
+  cs_int64 v;
+  if (TryToInt64(v)) return v;  // fits (no engine call)
+  HandBigInt a = csBigIntegerHANDparse(_data.data(), _data.size());
   cs_int64 i = a.get_si();  // signed long int
   return i;
 }
@@ -95,9 +122,9 @@ bool BigInteger::operator>(const BigInteger& big2) const {
   if (this->IsError() || big2.IsError()) return false;
 
   HandBigInt bThis =
-      csBigIntegerHANDparse(this->ToByteArray());  // parse from little-endian
+      csBigIntegerHANDparse(_data.data(), _data.size());  // parse big-endian
   HandBigInt bOther =
-      csBigIntegerHANDparse(big2.ToByteArray());  // parse from little-endian
+      csBigIntegerHANDparse(big2._data.data(), big2._data.size());
 
   bool r = (bThis > bOther);  // result
   return r;
@@ -109,9 +136,9 @@ bool BigInteger::operator<(const BigInteger& big2) const {
   }
 
   HandBigInt bThis =
-      csBigIntegerHANDparse(this->ToByteArray());  // parse from little-endian
+      csBigIntegerHANDparse(_data.data(), _data.size());  // parse big-endian
   HandBigInt bOther =
-      csBigIntegerHANDparse(big2.ToByteArray());  // parse from little-endian
+      csBigIntegerHANDparse(big2._data.data(), big2._data.size());
 
   bool r = (bThis < bOther);  // result
   return r;
@@ -130,11 +157,11 @@ BigInteger BigInteger::operator+(const BigInteger& big2) const {
   if (this->IsError() || big2.IsError()) return Error();
 
   HandBigInt bThis =
-      csBigIntegerHANDparse(this->ToByteArray());  // parse from little-endian
+      csBigIntegerHANDparse(_data.data(), _data.size());  // parse big-endian
   HandBigInt bOther =
-      csBigIntegerHANDparse(big2.ToByteArray());  // parse from little-endian
-  BigInteger r;                                   // result
-  r._data = csBigIntegerGetBytesFromHAND(bThis + bOther);  // get big-endian
+      csBigIntegerHANDparse(big2._data.data(), big2._data.size());
+  BigInteger r;  // result
+  csBigIntegerGetBytesFromHAND(bThis + bOther, r._data);  // get big-endian
   return r;
 }
 
@@ -142,46 +169,49 @@ BigInteger BigInteger::operator-(const BigInteger& big2) const {
   if (this->IsError() || big2.IsError()) return Error();
 
   HandBigInt bThis =
-      csBigIntegerHANDparse(this->ToByteArray());  // parse from little-endian
+      csBigIntegerHANDparse(_data.data(), _data.size());  // parse big-endian
   HandBigInt bOther =
-      csBigIntegerHANDparse(big2.ToByteArray());  // parse from little-endian
-  BigInteger r;                                   // result
-  r._data = csBigIntegerGetBytesFromHAND(bThis - bOther);  // get big-endian
+      csBigIntegerHANDparse(big2._data.data(), big2._data.size());
+  BigInteger r;  // result
+  csBigIntegerGetBytesFromHAND(bThis - bOther, r._data);  // get big-endian
   return r;
 }
 
 BigInteger BigInteger::operator*(const BigInteger& big2) const {
   if (this->IsError() || big2.IsError()) return Error();
+  if (polled(*this, big2)) return mulPolled(*this, big2);  // cancellable
 
   HandBigInt bThis =
-      csBigIntegerHANDparse(this->ToByteArray());  // parse from little-endian
+      csBigIntegerHANDparse(_data.data(), _data.size());  // parse big-endian
   HandBigInt bOther =
-      csBigIntegerHANDparse(big2.ToByteArray());  // parse from little-endian
-  BigInteger r;                                   // result
-  r._data = csBigIntegerGetBytesFromHAND(bThis * bOther);  // get big-endian
+      csBigIntegerHANDparse(big2._data.data(), big2._data.size());
+  BigInteger r;  // result
+  csBigIntegerGetBytesFromHAND(bThis * bOther, r._data);  // get big-endian
   return r;
 }
 
 BigInteger BigInteger::operator/(const BigInteger& big2) const {
   if (this->IsError() || big2.IsError() || big2.IsZero()) return Error();
+  if (polled(*this, big2)) return divPolled(*this, big2, false);
   HandBigInt bThis =
-      csBigIntegerHANDparse(this->ToByteArray());  // parse from little-endian
+      csBigIntegerHANDparse(_data.data(), _data.size());  // parse big-endian
   HandBigInt bOther =
-      csBigIntegerHANDparse(big2.ToByteArray());  // parse from little-endian
-  BigInteger r;                                   // result
-  r._data = csBigIntegerGetBytesFromHAND(bThis / bOther);  // get big-endian
+      csBigIntegerHANDparse(big2._data.data(), big2._data.size());
+  BigInteger r;  // result
+  csBigIntegerGetBytesFromHAND(bThis / bOther, r._data);  // get big-endian
   return r;
 }
 
 BigInteger BigInteger::operator%(const BigInteger& big2) const {
   if (this->IsError() || big2.IsError() || big2.IsZero()) return Error();
+  if (polled(*this, big2)) return divPolled(*this, big2, true);
 
   HandBigInt bThis =
-      csBigIntegerHANDparse(this->ToByteArray());  // parse from little-endian
+      csBigIntegerHANDparse(_data.data(), _data.size());  // parse big-endian
   HandBigInt bOther =
-      csBigIntegerHANDparse(big2.ToByteArray());  // parse from little-endian
-  BigInteger r;                                   // result
-  r._data = csBigIntegerGetBytesFromHAND(bThis % bOther);  // get big-endian
+      csBigIntegerHANDparse(big2._data.data(), big2._data.size());
+  BigInteger r;  // result
+  csBigIntegerGetBytesFromHAND(bThis % bOther, r._data);  // get big-endian
   return r;
 }
 
@@ -189,11 +219,11 @@ BigInteger BigInteger::operator<<(const BigInteger& big2) const {
   if (this->IsError() || big2.IsError()) return Error();
   if (big2 < Zero()) return (*this) >> -big2;
 
+  int shift = big2.toInt();
   HandBigInt bThis =
-      csBigIntegerHANDparse(this->ToByteArray());  // parse from little-endian
-  BigInteger r;                                    // result
-  r._data =
-      csBigIntegerGetBytesFromHAND(bThis << big2.toInt());  // get big-endian
+      csBigIntegerHANDparse(_data.data(), _data.size());  // parse big-endian
+  BigInteger r;  // result
+  csBigIntegerGetBytesFromHAND(bThis << shift, r._data);  // get big-endian
   return r;
 }
 
@@ -201,11 +231,11 @@ BigInteger BigInteger::operator>>(const BigInteger& big2) const {
   if (this->IsError() || big2.IsError()) return Error();
   if (big2 < Zero()) return (*this) << -big2;
 
+  int shift = big2.toInt();
   HandBigInt bThis =
-      csBigIntegerHANDparse(this->ToByteArray());  // parse from little-endian
-  BigInteger r;                                    // result
-  r._data =
-      csBigIntegerGetBytesFromHAND(bThis >> big2.toInt());  // get big-endian
+      csBigIntegerHANDparse(_data.data(), _data.size());  // parse big-endian
+  BigInteger r;  // result
+  csBigIntegerGetBytesFromHAND(bThis >> shift, r._data);  // get big-endian
   return r;
 }
 
@@ -214,154 +244,47 @@ BigInteger BigInteger::operator>>(const BigInteger& big2) const {
 std::string BigInteger::toStringBase10() const {
   // std::cout << "toStringBase10()" << std::endl;
   HandBigInt bThis =
-      csBigIntegerHANDparse(this->ToByteArray());  // parse from little-endian
+      csBigIntegerHANDparse(_data.data(), _data.size());  // parse big-endian
   // std::cout << "base10 -> " << bThis << std::endl;
   return bThis.get_str(10);
 }
 
-// assumes big >= 0
-std::string csBigIntegerGetBitsFromNonNegativeHAND(HandBigInt big) {
-  // TODO: remove!
-  assert(big >= 0);
-
-  std::string sbin;
-  while (big > 0) {
-    HandBigInt rest = (big % 2);
-    sbin.insert(0, (rest.get_ui() == 0 ? std::string("0") : std::string("1")));
-    big = big / 2;
-  }
-  return sbin;
-}
-
-cs_vbyte csBigIntegerGetBytesFromHAND(HandBigInt big) {
-  // std::cerr << "------ csBigIntegerGetBytesFromHAND: big -> " << big <<
-  // std::endl;
-  //
-  //  check if positive or negative
-  if (big >= 0) {
-    // -------------------
-    // positive conversion
-    // -------------------
-    cs_vbyte v;
-    while (big > 0) {
-      // std::cout << "big=" << big << std::endl;
-      HandBigInt rest = (big % 256);
-      // std::cout << "rest=" << rest << std::endl;
-      v.push_back((cs_byte)rest.get_ui());
-      // std::cout << "REST=" << rest.get_ui() << std::endl;
-      big = big / 256;
-    }
-
-    // added in little-endian format (backwards)
-    std::string leHex = Helper::toHexString(v);
-    if (leHex.length() == 0) leHex = "00";
-    // check if became negative
-    if (Helper::checkNegativeBit(leHex)) {
-      v.push_back(0);  // guarantee non-negative
-    }
-
-    // v is added backwards (little-endian), must reverse (to big-endian)
-    reverse(v.begin(), v.end());
-    if (v.size() == 0) v.push_back(0x00);
-    // finished
-    // std::cout << " ------ finished csBigIntegerGetBytesFromHAND" <<
-    // std::endl;
-    //
-    return v;
-  } else {
-    // std::cout << "IS NEGATIVE!" << std::endl;
-    //  -------------------
-    //  negative conversion
-    //  -------------------
-    //  turn into positive
-    HandBigInt x = big * (-1);
-    // std::cout << "x positive " << x << std::endl;
-
-    // ========================
-    // perform two's complement
-    // ========================
-    // convert to binary
-    cs_vbyte vx =
-        csBigIntegerGetBytesFromHAND(x);  // positive is easy to convert
-    // std::cout << Helper::toHexString(vx) << std::endl;
-    //
-    // HandBigInt bx(Helper::toHexString(vx), 16);
-    HandBigInt bx = HandBigInt::fromUnsignedHex(Helper::toHexString(vx));
-    // std::cout << "bx:" << bx.toString() << std::endl;
-    //
-
-    // get binary representation
-    std::string y = bx.get_str(2);
-    // std::cout << "numbits: " << y.length() << std::endl;
-    // std::cout << "ybits: " << y << std::endl;
-    // cout << "dbits: " << csBigIntegerGetBitsFromNonNegativeHAND(x) << endl;
-
-    // extra padding for limit cases (avoid overflow)
-    y.insert(0, "0");  // prepend
-
-    // guarantee length must be at least 8, or add padding!
-    while ((y.length() < 8) || (y.length() % 8 != 0)) {
-      y.insert(0, "0");  // prepend
-    }
-
-    // invert bits
-    std::string y2 = "";
-    for (int i = 0; i < (int)y.length(); i++) y2 += (y[i] == '0' ? '1' : '0');
-    // cout << "rbits: " << y2 << endl;
-
-    // go back to bigint
-    // BigInteger by3(y2, 2); // recursive behavior
-    //
-    // HandBigInt by3(y2, 2);
-    HandBigInt by3 = HandBigInt::fromUnsignedBin(y2);
-    //
-
-    // sum 1
-    HandBigInt bby3 = by3 + 1;
-
-    // cout << "(~y)+1: " << bby3 << endl;
-
-    // convert to binary again
-    std::string y4 = csBigIntegerGetBitsFromNonNegativeHAND(bby3);
-    // cout << "y4bits: " << y4 << endl;
-
-    // padding
-    while ((y4.length() < 8) || (y4.length() % 8 != 0)) {
-      y4.insert(0, "0");  // prepend
+template <class VByte>
+void csBigIntegerGetBytesFromHAND(const HandBigInt& big, VByte& out) {
+  HANDScratchPool& pool = csBigIntegerHANDpool();
+  // decimal digits (little-endian chars) to base 2^32 limbs (little-endian),
+  // consuming 9 digits at a time from most significant
+  std::vector<uint32_t>& limbs = pool.limbs;
+  limbs.clear();
+  const std::string& sdec = big.sdec;
+  int i = static_cast<int>(sdec.size());
+  while (i > 0) {
+    int len = ((i - 1) % 9) + 1;  // first chunk is the short one
+    uint32_t chunk = 0;
+    uint32_t mul = 1;
+    for (int k = 0; k < len; k++) {
+      chunk = chunk * 10 + (sdec[i - 1 - k] - '0');
+      mul *= 10;
     }
-
-    // cout << "y4bits: " << y4 << endl;
-
-    // get in bytes
-    cs_vbyte v = Helper::BinToBytes(y4);
-
-    // cout << "v: " << Helper::toHexString(v) << endl;
-
-    // convert to little-endian
-    reverse(v.begin(), v.end());  // to little-endian
-
-    // will add extra ff to guarantee its negative, and simplify later (remove
-    // extra ff)
-    v.push_back(0xff);
-
-    cs_vbyte vsimple = v;
-    while ((vsimple.size() > 1) &&
-           (vsimple.at(((int)vsimple.size()) - 1) == 0xff)) {
-      vsimple.pop_back();
-      std::string lehex = Helper::toHexString(vsimple);
-      if (Helper::checkNegativeBit(lehex)) {
-        // still negative! can keep removal
-        v = vsimple;
-      } else
-        break;
+    i -= len;
+    // limbs = limbs * mul + chunk
+    uint64_t carry = chunk;
+    for (size_t j = 0; j < limbs.size(); j++) {
+      carry += static_cast<uint64_t>(limbs[j]) * mul;
+      limbs[j] = static_cast<uint32_t>(carry);
+      carry >>= 32;
     }
-
-    // convert to big-endian
-    reverse(v.begin(), v.end());  // to big-endian
-
-    // finished
-    return v;
+    if (carry > 0) limbs.push_back(static_cast<uint32_t>(carry));
   }
+  // magnitude (big-endian bytes)
+  cs_vbyte& mag = pool.bytes;
+  mag.resize(limbs.size() * 4);
+  for (size_t j = 0; j < limbs.size(); j++)
+    for (int b = 0; b < 4; b++)
+      mag[mag.size() - 1 - (j * 4 + b)] =
+          static_cast<cs_byte>(limbs[j] >> (8 * b));
+  // two's complement (most compressed format)
+  Helper::fromMagnitude(mag.data(), mag.size(), big.sign == -1, out);
 }
 
 // taken from csBigInteger.js
@@ -383,104 +306,46 @@ cs_vbyte csBigIntegerGetBytesFromHAND(HandBigInt big) {
                 a <BigInteger> instance.
 */
 
-// expects vbyte on little-endian format (raw internal format)
-HandBigInt csBigIntegerHANDparse(cs_vbyte n) {
-  // std::cerr << "csBigIntegerHANDparse(" << Helper::toHexString(n) << ")" <<
-  // std::endl;
-  //
-  // if (n.size() == 0)
-  //    return HandBigInt(0); // never invoked
-
-  std::string s = Helper::toHexString(n);
-  // std::cout << "  ---> s => 0x" << s << std::endl;
-
-  // verify if number is negative (most significant bit)
-  if (Helper::checkNegativeBit(s)) {
-    // std::cout << "csBigIntegerHANDparse is negative!" << std::endl;
-    //  is negative, must handle twos-complement
-    //
-    // HandBigInt vint(Helper::revertHexString(s), 16); // as big-endian again
-    HandBigInt vint = HandBigInt::fromUnsignedHex(Helper::revertHexString(s));
-    // std::cout << "csBigIntegerHANDparse vint=" << vint.toString() <<
-    // std::endl;
-    //
-    //
-    //  get bitstring
-    std::string rbitnum = csBigIntegerGetBitsFromNonNegativeHAND(vint);
-    // std::cout << "rbitnum = " << rbitnum << std::endl;
-    //  negate bits
-    std::stringstream y2;
-    for (int i = 0; i < (int)rbitnum.length(); i++)
-      y2 << (rbitnum[i] == '0' ? '1' : '0');
-    // to bigint again
-    //
-    // HandBigInt by2(y2.str(), 2);
-    HandBigInt by2 = HandBigInt::fromUnsignedBin(y2.str());
-    // std::cout << "by2 = " << by2.toString() << std::endl;
-    //
-    //  add one
-    HandBigInt by2add = by2 + 1;
-    // std::cout << "by2add = " << by2add.toString() << std::endl;
-    //  get negative
-    HandBigInt finalnum = by2add * (-1);
-    // std::cout << "finalnum = " << finalnum.toString() << std::endl;
-    //  ensure it's negative (TODO: remove)
-    assert(finalnum < 0);  // must be negative
-    // finished
-    return finalnum;
-  } else {
-    // positive is easy (in little-endian format)
-    std::string sbig = Helper::revertHexString(s);
-    //
-    // build bignum in big-endian
-    // return HandBigInt(sbig, 16); // big-endian again
-    return HandBigInt::fromUnsignedHex(sbig);  // big-endian again
+// expects big-endian two's complement bytes (raw internal format)
+HandBigInt csBigIntegerHANDparse(const cs_byte* data, size_t n) {
+  HANDScratchPool& pool = csBigIntegerHANDpool();
+  // verify if number is negative (most significant bit), and get magnitude
+  cs_vbyte& mag = pool.bytes;
+  bool negative = Helper::toMagnitude(data, n, mag);
+  // magnitude to base 10^9 limbs (little-endian), byte by byte
+  std::vector<uint32_t>& limbs = pool.limbs;
+  limbs.clear();
+  for (size_t i = 0; i < mag.size(); i++) {
+    uint64_t carry = mag[i];
+    for (size_t j = 0; j < limbs.size(); j++) {
+      carry += static_cast<uint64_t>(limbs[j]) * 256;
+      limbs[j] = static_cast<uint32_t>(carry % 1000000000);
+      carry /= 1000000000;
+    }
+    if (carry > 0) limbs.push_back(static_cast<uint32_t>(carry));
+  }
+  // internal format of HandBigInt: reversed decimal string
+  HandBigInt big;
+  big.sdec.reserve(limbs.size() * 9 + 1);
+  for (size_t j = 0; j < limbs.size(); j++) {
+    uint32_t limb = limbs[j];
+    for (int k = 0; k < 9; k++) {
+      big.sdec += static_cast<char>('0' + limb % 10);
+      limb /= 10;
+    }
   }
+  if (big.sdec.empty()) big.sdec = "0";
+  big.fix(negative ? -1 : 1);  // erase extra zeroes
+  return big;
 }
 
-HandBigInt csBigIntegerHANDparses(std::string n, int base) {
-  // std::cerr << "   --> csBigIntegerHANDparses(n='" << n << "' base =" << base
-  // << ")" << std::endl;
+HandBigInt csBigIntegerHANDparses(const std::string& n) {
+  // std::cerr << "   --> csBigIntegerHANDparses(n='" << n << "')" << std::endl;
   //
-  if (base == 10) {
-    // if (n.length() == 0)
-    //    n = "0"; // not necessary
-    HandBigInt h(n);
-    // std::cout << " --> csBigIntegerHANDparses ---> h=" << h.toString() <<
-    // std::endl;
-    return h;
-  }
-
-  // never used! internal function only
-  // if (base == 2) {
-  //   if (n.length() == 0)
-  //      n = "0";
-  //   return HandBigInt(n, base);
-  //}
-
-  // never used! internal function only
-  // if (base != 16) {
-  //   cout << "UNSUPPORTED BASE! " << base << endl;
-  //   exit(1);
-  //}
-
-  // zero padding
-  while (n.length() < 2) n.insert(0, "0");
-
-  // return bytearray initialized
-  cs_vbyte vb;
-  // prefix '0x' optional. input always big-endian
-  if ((n[0] == '0') && (n[1] == 'x')) {
-    // removing '0x'
-    n = n.substr(2, n.length() - 2);
-    vb = Helper::HexToBytes(n);
-
-  } else {
-    vb = Helper::HexToBytes(n);  // directly reading big-endian byte array
-  }
-
-  reverse(vb.begin(), vb.end());  // to little-endian
-
-  // base 16
-  return csBigIntegerHANDparse(vb);  // vb is little-endian byte array
+  // if (n.length() == 0)
+  //    n = "0"; // not necessary
+  HandBigInt h(n);
+  // std::cout << " --> csBigIntegerHANDparses ---> h=" << h.toString() <<
+  // std::endl;
+  return h;
 }
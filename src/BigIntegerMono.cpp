@@ -94,14 +94,22 @@ MonoObject* executeOp(std::string op, cs_vbyte bytes1, cs_vbyte bytes2) {
 
 std::string BigInteger::getEngine() { return "Mono"; }
 
+bool BigInteger::OperandCacheStats(cs_uint64& hits, cs_uint64& misses) {
+  hits = misses = 0;
+  return false;  // no operand cache
+}
+
 const BigInteger BigInteger::error() {
   BigInteger big;
-  big._data = cs_vbyte(0);  // empty array is error
+  big._data.clear();  // empty array is error
   return big;
 }
 
 BigInteger BigInteger::Pow(BigInteger value, int exponent) {
   if (exponent < 0) return BigInteger::Error();
+  // polled (progress and cancellation)
+  if (BigIntegerContext::Current() != nullptr)
+    return powPolled(value, exponent);
   MonoObject* bigLib = mono_object_new(domain, biglibclass);
   mono_runtime_object_init(bigLib);
 
@@ -133,6 +141,12 @@ BigInteger BigInteger::Pow(BigInteger value, int exponent) {
 // allows base 2
 // if base 16, prefix '0x' indicates big-endian, otherwise is little-endian
 BigInteger::BigInteger(string str, int base) {
+  if (base == 10) {
+    // plain decimal (optional '-') goes through shared SWAR parser
+    std::from_chars_result r = FromChars(str, *this, 10);
+    if ((r.ec == std::errc()) && (r.ptr == str.data() + str.size())) return;
+  }
+
   MonoObject* bigLib = mono_object_new(domain, biglibclass);
   mono_runtime_object_init(bigLib);
 
@@ -158,34 +172,7 @@ BigInteger::BigInteger(string str, int base) {
   MonoObject* retarr = mono_runtime_invoke(method, bigLib, args, nullptr);
 
   MonoArray* arr = (MonoArray*)retarr;
-  _data = mono_bytearray_to_bytearray(arr);
-  std::reverse(_data.begin(), _data.end());  // to big-endian (internal)
-}
-
-BigInteger::BigInteger(float x) {
-  MonoObject* bigLib = mono_object_new(domain, biglibclass);
-  mono_runtime_object_init(bigLib);
-
-  string sMyMethodStr = "BigIntegerLib:from_float(single)";
-  MonoMethodDesc* MyMethod = mono_method_desc_new(sMyMethodStr.c_str(), false);
-  if (!MyMethod) {
-    std::cout << "mono_method_desc_new failed" << std::endl;
-    exit(1);
-  }
-
-  MonoMethod* method = mono_method_desc_search_in_image(MyMethod, image);
-  if (!method) {
-    std::cout << "mono_method_desc_search_in_image (float) failed" << std::endl;
-    exit(1);
-  }
-
-  void* args[1];
-  args[0] = &x;
-
-  MonoObject* retarr = mono_runtime_invoke(method, bigLib, args, nullptr);
-
-  MonoArray* arr = (MonoArray*)retarr;
-  _data = mono_bytearray_to_bytearray(arr);
+  setData(mono_bytearray_to_bytearray(arr));
   std::reverse(_data.begin(), _data.end());  // to big-endian (internal)
 }
 
@@ -223,6 +210,9 @@ string BigInteger::toStringBase10() const {
 }
 
 cs_int32 BigInteger::toInt() const {
+  cs_int64 v;
+  if (TryToInt64(v) && (v == static_cast<cs_int32>(v)))
+    return static_cast<cs_int32>(v);  // fits (no engine call)
   MonoObject* bigLib = mono_object_new(domain, biglibclass);
   mono_runtime_object_init(bigLib);
 
@@ -250,6 +240,8 @@ cs_int32 BigInteger::toInt() const {
 }
 
 cs_int64 BigInteger::toLong() const {
+  cs_int64 v;
+  if (TryToInt64(v)) return v;  // fits (no engine call)
   MonoObject* bigLib = mono_object_new(domain, biglibclass);
   mono_runtime_object_init(bigLib);
 
@@ -319,6 +311,7 @@ BigInteger BigInteger::operator-(const BigInteger& big2) const {
 
 BigInteger BigInteger::operator*(const BigInteger& big2) const {
   if (this->IsError() || big2.IsError()) return Error();
+  if (polled(*this, big2)) return mulPolled(*this, big2);  // cancellable
 
   string op = "BigIntegerLib:mul(byte[],byte[])";
   MonoObject* retarr = ::executeOp(op, this->ToByteArray(), big2.ToByteArray());
@@ -328,6 +321,7 @@ BigInteger BigInteger::operator*(const BigInteger& big2) const {
 
 BigInteger BigInteger::operator/(const BigInteger& big2) const {
   if (this->IsError() || big2.IsError() || big2.IsZero()) return Error();
+  if (polled(*this, big2)) return divPolled(*this, big2, false);
   // cout << "dividing " << this->toInt() << " / " << big2.toInt() << " " <<
   // endl; cout << "dividing " << this->ToString(16) << " / " <<
   // big2.ToString(16) << " " << endl;
@@ -339,6 +333,7 @@ BigInteger BigInteger::operator/(const BigInteger& big2) const {
 
 BigInteger BigInteger::operator%(const BigInteger& big2) const {
   if (this->IsError() || big2.IsError() || big2.IsZero()) return Error();
+  if (polled(*this, big2)) return divPolled(*this, big2, true);
 
   string op = "BigIntegerLib:mod(byte[],byte[])";
   MonoObject* retarr = ::executeOp(op, this->ToByteArray(), big2.ToByteArray());
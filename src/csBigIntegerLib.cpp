@@ -2,6 +2,25 @@
 
 // import big integer
 #include <csbiginteger/BigInteger.h>
+#include <csbiginteger/Reduction.hpp>
+
+// c
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 // using namespace csbiginteger;
 
@@ -218,4 +237,284 @@ CSBIGINTEGER_EXTERN_C cs_int32 csbiginteger_pow(cs_byte* big, int sz_big,
   if (b3 == csbiginteger::BigInteger::Error()) return 0;  // error
   if (!b3.CopyTo(vr, sz_vr)) return 0;                    // error
   return b3.Length();
-}
\ No newline at end of file
+}
+
+// ==========================
+// reductions (packed buffers)
+// ==========================
+
+// unpack 'count' little-endian values concatenated in 'vb'
+static std::vector<csbiginteger::BigInteger> csbiginteger_unpack(
+    cs_byte* vb, cs_int32* sizes, int count) {
+  std::vector<csbiginteger::BigInteger> values;
+  values.reserve(count);
+  for (int i = 0; i < count; i++) {
+    values.emplace_back(cs_vbyte(vb, vb + sizes[i]));
+    vb += sizes[i];
+  }
+  return values;
+}
+
+CSBIGINTEGER_EXTERN_C cs_int32 csbiginteger_sum(cs_byte* vb, cs_int32* sizes,
+                                                int count, int nthreads,
+                                                cs_byte* vr, int sz_vr) {
+  csbiginteger::BigInteger b3 =
+      csbiginteger::Sum(csbiginteger_unpack(vb, sizes, count), nthreads);
+  if (b3 == csbiginteger::BigInteger::Error()) return 0;  // error
+  if (!b3.CopyTo(vr, sz_vr)) return 0;                    // error
+  return b3.Length();
+}
+
+CSBIGINTEGER_EXTERN_C cs_int32 csbiginteger_product(cs_byte* vb,
+                                                    cs_int32* sizes, int count,
+                                                    int nthreads, cs_byte* vr,
+                                                    int sz_vr) {
+  csbiginteger::BigInteger b3 =
+      csbiginteger::Product(csbiginteger_unpack(vb, sizes, count), nthreads);
+  if (b3 == csbiginteger::BigInteger::Error()) return 0;  // error
+  if (!b3.CopyTo(vr, sz_vr)) return 0;                    // error
+  return b3.Length();
+}
+
+CSBIGINTEGER_EXTERN_C cs_int32 csbiginteger_dot(cs_byte* va, cs_int32* sizes_a,
+                                                cs_byte* vb, cs_int32* sizes_b,
+                                                int count, int nthreads,
+                                                cs_byte* vr, int sz_vr) {
+  csbiginteger::BigInteger b3 =
+      csbiginteger::Dot(csbiginteger_unpack(va, sizes_a, count),
+                        csbiginteger_unpack(vb, sizes_b, count), nthreads);
+  if (b3 == csbiginteger::BigInteger::Error()) return 0;  // error
+  if (!b3.CopyTo(vr, sz_vr)) return 0;                    // error
+  return b3.Length();
+}
+
+// ==============================================
+// asynchronous rings (submission and completion)
+// ==============================================
+
+// bounded lock-free queue (sequence number per cell): used with a single
+// producer for submissions and a single consumer for completions
+template <class T>
+class csbiginteger_queue {
+ public:
+  explicit csbiginteger_queue(size_t size) : cells(size), mask(size - 1) {
+    for (size_t i = 0; i < size; i++) cells[i].seq.store(i);
+  }
+
+  bool push(const T& value) {
+    size_t pos = tail.load(std::memory_order_relaxed);
+    Cell* c;
+    while (true) {
+      c = &cells[pos & mask];
+      size_t seq = c->seq.load(std::memory_order_acquire);
+      std::ptrdiff_t dif = static_cast<std::ptrdiff_t>(seq - pos);
+      if (dif < 0) return false;  // full
+      if ((dif == 0) &&
+          tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        break;
+      if (dif > 0) pos = tail.load(std::memory_order_relaxed);
+    }
+    c->value = value;
+    c->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(T& value) {
+    size_t pos = head.load(std::memory_order_relaxed);
+    Cell* c;
+    while (true) {
+      c = &cells[pos & mask];
+      size_t seq = c->seq.load(std::memory_order_acquire);
+      std::ptrdiff_t dif = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+      if (dif < 0) return false;  // empty
+      if ((dif == 0) &&
+          head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        break;
+      if (dif > 0) pos = head.load(std::memory_order_relaxed);
+    }
+    value = c->value;
+    c->seq.store(pos + mask + 1, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> seq;
+    T value;
+  };
+
+  std::vector<Cell> cells;
+  size_t mask;
+  alignas(64) std::atomic<size_t> tail{0};
+  alignas(64) std::atomic<size_t> head{0};
+};
+
+struct csbiginteger_ring {
+  csbiginteger_queue<csbiginteger_sqe> sq;
+  csbiginteger_queue<csbiginteger_cqe> cq;
+  size_t entries;
+  std::atomic<size_t> inflight{0};  // submitted, not reaped
+  std::vector<std::thread> workers;
+  // idle workers sleep on 'cv' ('sleeping' lets submit skip the lock)
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::atomic<int> sleeping{0};
+  bool stopping{false};
+  int fd[2];  // completion notification (read, write)
+
+  explicit csbiginteger_ring(size_t entries)
+      : sq(entries), cq(entries), entries(entries) {}
+
+  void notify() {
+    cs_int64 one = 1;
+    while ((::write(fd[1], &one, sizeof(one)) < 0) && (errno == EINTR)) {
+    }
+  }
+
+  void drain() {
+    cs_int64 buf[8];
+    while (::read(fd[0], buf, sizeof(buf)) > 0) {
+    }
+  }
+
+  void work() {
+    csbiginteger_sqe e;
+    while (true) {
+      if (!sq.pop(e)) {
+        std::unique_lock<std::mutex> lock(mutex);
+        sleeping++;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!sq.pop(e)) {
+          if (stopping) {
+            sleeping--;
+            return;
+          }
+          cv.wait(lock);
+        }
+        sleeping--;
+      }
+      cs_int32 r = 0;
+      switch (e.op) {
+        case CSBIGINTEGER_OP_ADD:
+          r = csbiginteger_add(e.big1, e.sz_big1, e.big2, e.sz_big2, e.vr,
+                               e.sz_vr);
+          break;
+        case CSBIGINTEGER_OP_SUB:
+          r = csbiginteger_sub(e.big1, e.sz_big1, e.big2, e.sz_big2, e.vr,
+                               e.sz_vr);
+          break;
+        case CSBIGINTEGER_OP_MUL:
+          r = csbiginteger_mul(e.big1, e.sz_big1, e.big2, e.sz_big2, e.vr,
+                               e.sz_vr);
+          break;
+        case CSBIGINTEGER_OP_DIV:
+          r = csbiginteger_div(e.big1, e.sz_big1, e.big2, e.sz_big2, e.vr,
+                               e.sz_vr);
+          break;
+        case CSBIGINTEGER_OP_MOD:
+          r = csbiginteger_mod(e.big1, e.sz_big1, e.big2, e.sz_big2, e.vr,
+                               e.sz_vr);
+          break;
+        case CSBIGINTEGER_OP_SHL:
+          r = csbiginteger_shl(e.big1, e.sz_big1, e.big2, e.sz_big2, e.vr,
+                               e.sz_vr);
+          break;
+        case CSBIGINTEGER_OP_SHR:
+          r = csbiginteger_shr(e.big1, e.sz_big1, e.big2, e.sz_big2, e.vr,
+                               e.sz_vr);
+          break;
+        case CSBIGINTEGER_OP_POW:
+          r = csbiginteger_pow(e.big1, e.sz_big1, e.exp, e.vr, e.sz_vr);
+          break;
+      }
+      // never full: at most 'entries' in flight
+      cq.push(csbiginteger_cqe{e.tag, r});
+      notify();
+    }
+  }
+};
+
+CSBIGINTEGER_EXTERN_C csbiginteger_ring* csbiginteger_ring_create(
+    int entries, int nthreads) {
+  if (entries <= 0) return nullptr;
+  size_t size = 1;
+  while (size < static_cast<size_t>(entries)) size <<= 1;
+  unsigned n = (nthreads > 0) ? nthreads : std::thread::hardware_concurrency();
+  csbiginteger_ring* ring = new csbiginteger_ring(size);
+#ifdef __linux__
+  ring->fd[0] = ring->fd[1] = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  bool ok = ring->fd[0] >= 0;
+#else
+  bool ok = ::pipe(ring->fd) == 0;
+  if (ok) {
+    ::fcntl(ring->fd[0], F_SETFL, O_NONBLOCK);
+    ::fcntl(ring->fd[1], F_SETFL, O_NONBLOCK);
+  }
+#endif
+  if (!ok) {
+    delete ring;
+    return nullptr;
+  }
+  for (unsigned t = 0; t < std::max(1u, n); t++)
+    ring->workers.emplace_back([ring]() { ring->work(); });
+  return ring;
+}
+
+CSBIGINTEGER_EXTERN_C void csbiginteger_ring_destroy(csbiginteger_ring* ring) {
+  if (ring == nullptr) return;
+  {
+    std::lock_guard<std::mutex> lock(ring->mutex);
+    ring->stopping = true;
+  }
+  ring->cv.notify_all();
+  for (std::thread& t : ring->workers) t.join();
+  ::close(ring->fd[0]);
+  if (ring->fd[1] != ring->fd[0]) ::close(ring->fd[1]);
+  delete ring;
+}
+
+CSBIGINTEGER_EXTERN_C bool csbiginteger_ring_submit(
+    csbiginteger_ring* ring, const csbiginteger_sqe* sqe) {
+  if ((sqe->op < CSBIGINTEGER_OP_ADD) || (sqe->op > CSBIGINTEGER_OP_POW))
+    return false;
+  if (ring->inflight.load() >= ring->entries) return false;
+  ring->inflight++;
+  ring->sq.push(*sqe);
+  // wake a worker only when some is idle
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (ring->sleeping.load() > 0) {
+    std::lock_guard<std::mutex> lock(ring->mutex);
+    ring->cv.notify_one();
+  }
+  return true;
+}
+
+CSBIGINTEGER_EXTERN_C int csbiginteger_ring_wait(csbiginteger_ring* ring,
+                                                 csbiginteger_cqe* cqes,
+                                                 int max, int timeout_ms) {
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(std::max(0, timeout_ms));
+  while (true) {
+    ring->drain();
+    int n = 0;
+    while ((n < max) && ring->cq.pop(cqes[n])) n++;
+    if (n > 0) {
+      ring->inflight -= n;
+      return n;
+    }
+    if ((timeout_ms == 0) || (max <= 0)) return 0;
+    int wait = -1;
+    if (timeout_ms > 0) {
+      auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+          deadline - std::chrono::steady_clock::now());
+      if (left.count() <= 0) return 0;
+      wait = static_cast<int>(left.count());
+    }
+    pollfd p{ring->fd[0], POLLIN, 0};
+    ::poll(&p, 1, wait);
+  }
+}
+
+CSBIGINTEGER_EXTERN_C int csbiginteger_ring_fd(csbiginteger_ring* ring) {
+  return ring->fd[0];
+}
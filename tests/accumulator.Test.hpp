@@ -0,0 +1,66 @@
+#include <catch2/catch_amalgamated.hpp>
+
+// system
+#include <limits>
+
+// core includes
+#ifdef TEST_CSBIGINTEGER_LIB
+#include <csbiginteger/csBigIntegerLibClass.hpp>
+using namespace csbigintegerlib;
+#else
+#include <csbiginteger/BigInteger.h>
+#include <csbiginteger/BigIntegerAccumulator.hpp>
+using namespace csbiginteger;
+#endif
+
+using namespace std;
+
+#ifndef TEST_CSBIGINTEGER_LIB
+
+TEST_CASE("csBIAccumulatorTests:  Empty_Is_Zero") {
+  BigIntegerAccumulator acc;
+  REQUIRE(acc.ToBigInteger() == BigInteger::Zero());
+  BigIntegerAccumulator acc0(0);
+  acc0 += cs_int64{-1};
+  REQUIRE(acc0.ToBigInteger() == BigInteger::MinusOne());
+}
+
+TEST_CASE("csBIAccumulatorTests:  Add_Sub_BigInteger_And_Int64") {
+  BigInteger big("340282366920938463463374607431768211456", 10);  // 2^128
+  BigIntegerAccumulator acc;
+  BigInteger expected = BigInteger::Zero();
+  for (int i = 0; i < 1000; i++) {
+    BigInteger x = big * BigInteger(i % 7 - 3) + BigInteger(i);
+    if (i % 2) {
+      acc += x;
+      expected = expected + x;
+    } else {
+      acc -= x;
+      expected = expected - x;
+    }
+    acc += cs_int64{i} * 1000000007;
+    expected = expected + BigInteger(cs_int64{i} * 1000000007);
+  }
+  REQUIRE(acc.ToBigInteger() == expected);
+  // still usable after normalization
+  acc -= expected;
+  acc -= std::numeric_limits<cs_int64>::min();
+  REQUIRE(acc.ToBigInteger() ==
+          BigInteger(std::numeric_limits<cs_int64>::max()) + BigInteger::One());
+  acc.clear();
+  acc -= big;
+  REQUIRE(acc.ToBigInteger() == -big);
+}
+
+TEST_CASE("csBIAccumulatorTests:  Sign_Crossing_And_Error") {
+  BigIntegerAccumulator acc(BigInteger(-128));
+  acc += BigInteger(255);
+  acc -= cs_int64{127};
+  REQUIRE(acc.ToBigInteger() == BigInteger::Zero());
+  acc -= BigInteger(256);
+  REQUIRE(acc.ToBigInteger() == BigInteger(-256));
+  acc += BigInteger::Error();
+  REQUIRE(acc.ToBigInteger() == BigInteger::Error());
+}
+
+#endif
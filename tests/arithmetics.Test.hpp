@@ -358,3 +358,33 @@ TEST_CASE("csBIArithmeticsTests:  Update with operator=") {
   bi = {bi * sz + d};
   REQUIRE(bi == 30);
 }
+
+#ifndef TEST_CSBIGINTEGER_LIB
+
+TEST_CASE("csBIArithmeticsTests:  Repeated operands (operand cache)") {
+  BigInteger m = (BigInteger::One() << 255) - BigInteger(19);
+  BigInteger c = m / BigInteger(3);
+  cs_uint64 hits0, misses0;
+  bool cached = BigInteger::OperandCacheStats(hits0, misses0);
+  // more distinct operands than cached ones (entries are replaced)
+  BigInteger x = c;
+  for (int i = 0; i < 200; i++) {
+    BigInteger a = m - BigInteger(i * 7919);
+    REQUIRE((a * c) / c == a);
+    REQUIRE(((a * c) % m) == ((a % m) * (c % m)) % m);
+    REQUIRE((a > m) == false);
+    x = (x * c + a) % m;
+    REQUIRE(x < m);
+  }
+  REQUIRE(x == (x << 64) >> 64);
+  cs_uint64 hits, misses;
+  REQUIRE(BigInteger::OperandCacheStats(hits, misses) == cached);
+  if (cached) {
+    REQUIRE(hits > hits0 + 200);  // m and c
+    REQUIRE(misses > misses0);
+  } else {
+    REQUIRE(hits + misses == 0);
+  }
+}
+
+#endif
@@ -0,0 +1,126 @@
+#include <catch2/catch_amalgamated.hpp>
+
+// system
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+
+// core includes
+#ifdef TEST_CSBIGINTEGER_LIB
+#include <csbiginteger/csBigIntegerLibClass.hpp>
+using namespace csbigintegerlib;
+#else
+#include <csbiginteger/BigInteger.h>
+#include <csbiginteger/BigIntegerAsync.hpp>
+using namespace csbiginteger;
+#endif
+
+using namespace std;
+
+#if !defined(TEST_CSBIGINTEGER_LIB) && defined(__cpp_impl_coroutine)
+
+// eager coroutine, 'finished' is set when it returns
+struct csBITask {
+  struct promise_type {
+    std::promise<void> done;
+    csBITask get_return_object() { return {done.get_future()}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() { done.set_value(); }
+    void unhandled_exception() { done.set_exception(current_exception()); }
+  };
+  std::future<void> finished;
+};
+
+static csBITask csBIAwaitAll(BigInteger a, BigInteger b, BigInteger& product,
+                             BigInteger& power, string& digits,
+                             thread::id& resumed) {
+  product = co_await async::multiply(a, b);
+  resumed = this_thread::get_id();
+  power = co_await async::pow(a, 37);
+  digits = co_await async::toString(power);
+}
+
+TEST_CASE("csBIAsyncTests:  Await_Same_As_Sync") {
+  BigInteger a = BigInteger::Parse("-123456789012345678901234567890");
+  BigInteger b(987654321);
+  BigInteger product, power;
+  string digits;
+  thread::id resumed;
+  csBIAwaitAll(a, b, product, power, digits, resumed).finished.get();
+  REQUIRE(product == a * b);
+  REQUIRE(resumed != this_thread::get_id());  // resumed on executor
+  REQUIRE(power == BigInteger::Pow(a, 37));
+  REQUIRE(digits == power.ToString(10));
+  // blocks of base 10 conversion (several splits)
+  BigInteger big = BigInteger::PowerOf10(30000) - BigInteger::One();
+  string s;
+  [](BigInteger x, string& out) -> csBITask {
+    out = co_await async::toString(x);
+  }(big, s).finished.get();
+  REQUIRE(s == string(30000, '9'));
+}
+
+TEST_CASE("csBIAsyncTests:  Cancellation") {
+  async::Executor executor(1);
+  async::CancellationToken token;
+  token.Cancel();
+  BigInteger r = BigInteger::One();
+  string s = "x";
+  [](async::CancellationToken t, async::Executor& ex, BigInteger& out,
+     string& str) -> csBITask {
+    out = co_await async::multiply(BigInteger(2), BigInteger(3), t, ex);
+    str = co_await async::toString(BigInteger(5), 10, t, ex);
+  }(token, executor, r, s).finished.get();
+  REQUIRE(r == BigInteger::Error());
+  REQUIRE(s.empty());
+  // runaway pow stops at next squaring
+  async::CancellationToken timeout;
+  auto t0 = chrono::steady_clock::now();
+  csBITask task = [](async::CancellationToken t, async::Executor& ex,
+                     BigInteger& out) -> csBITask {
+    out = co_await async::pow(BigInteger(3), 1 << 26, t, ex);
+  }(timeout, executor, r);
+  this_thread::sleep_for(chrono::milliseconds(20));
+  timeout.Cancel();
+  task.finished.get();
+  REQUIRE(r == BigInteger::Error());
+  REQUIRE(chrono::steady_clock::now() - t0 < chrono::seconds(30));
+  // multi-megabit multiply, cancelled while running
+  cs_vbyte bytes(size_t{1} << 19, 0x5a);
+  BigInteger big(bytes);
+  async::CancellationToken during;
+  t0 = chrono::steady_clock::now();
+  task = [](BigInteger x, async::CancellationToken t, async::Executor& ex,
+            BigInteger& out) -> csBITask {
+    out = co_await async::multiply(x, x, t, ex);
+  }(big, during, executor, r);
+  this_thread::sleep_for(chrono::milliseconds(20));
+  during.Cancel();
+  task.finished.get();
+  REQUIRE(r == BigInteger::Error());
+  REQUIRE(chrono::steady_clock::now() - t0 < chrono::seconds(10));
+}
+
+TEST_CASE("csBIAsyncTests:  Token_Context") {
+  // operations run under the context of their token (polled on executor)
+  async::Executor executor(1);
+  async::CancellationToken token;
+  size_t polls = 0;
+  token.Context()->progress = [&polls](const char*, size_t, size_t) {
+    polls++;
+  };
+  BigInteger r;
+  string s;
+  [](async::CancellationToken t, async::Executor& ex, BigInteger& out,
+     string& str) -> csBITask {
+    out = co_await async::pow(BigInteger(3), 1000, t, ex);
+    str = co_await async::toString(out, 10, t, ex);
+  }(token, executor, r, s).finished.get();
+  REQUIRE(r == BigInteger::Pow(BigInteger(3), 1000));
+  REQUIRE(s == r.ToString(10));
+  REQUIRE(polls >= 12);  // 11 "pow" polls, then "write_decimal" blocks
+}
+
+#endif
@@ -0,0 +1,304 @@
+#include <catch2/catch_amalgamated.hpp>
+
+// system
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// core includes
+#ifdef TEST_CSBIGINTEGER_LIB
+#include <csbiginteger/csBigIntegerLibClass.hpp>
+using namespace csbigintegerlib;
+#else
+#include <csbiginteger/BigInteger.h>
+using namespace csbiginteger;
+#endif
+
+using namespace std;
+
+#ifndef TEST_CSBIGINTEGER_LIB
+
+// ToChars into fixed buffer, as string
+static string csBIToChars(const BigInteger& big, int base) {
+  char buf[4096];
+  auto r = big.ToChars(buf, buf + sizeof(buf), base);
+  REQUIRE(r.ec == std::errc());
+  return string(buf, r.ptr);
+}
+
+TEST_CASE("csBICharsTests:  ToChars_Bases") {
+  REQUIRE(csBIToChars(BigInteger::Zero(), 10) == "0");
+  REQUIRE(csBIToChars(BigInteger::Zero(), 16) == "0");
+  REQUIRE(csBIToChars(BigInteger(-1), 10) == "-1");
+  REQUIRE(csBIToChars(BigInteger(255), 16) == "ff");
+  REQUIRE(csBIToChars(BigInteger(-256), 16) == "-100");
+  REQUIRE(csBIToChars(BigInteger(5), 2) == "101");
+  REQUIRE(csBIToChars(BigInteger(-128), 2) == "-10000000");
+  string s = "-123456789012345678901234567890123456789012345678901234567890";
+  REQUIRE(csBIToChars(BigInteger(s, 10), 10) == s);
+  REQUIRE(csBIToChars(BigInteger("10000000000000000000", 10), 10) ==
+          "10000000000000000000");  // exactly one 19-digit chunk boundary
+  BigInteger big = BigInteger::Pow(BigInteger(2), 200) - BigInteger::One();
+  REQUIRE(csBIToChars(big, 10) == big.ToString(10));
+  REQUIRE(csBIToChars(big, 16) == string(50, 'f'));
+  REQUIRE(csBIToChars(big, 2) == string(200, '1'));
+}
+
+TEST_CASE("csBICharsTests:  ToChars_Buffer_Too_Small") {
+  char buf[4];
+  auto r = BigInteger(12345).ToChars(buf, buf + 4);
+  REQUIRE(r.ec == std::errc::value_too_large);
+  REQUIRE(r.ptr == buf + 4);
+  r = BigInteger(-1234).ToChars(buf, buf + 4, 10);
+  REQUIRE(r.ec == std::errc::value_too_large);
+  r = BigInteger(-123).ToChars(buf, buf + 4, 10);
+  REQUIRE(r.ec == std::errc());
+  REQUIRE(string(buf, r.ptr) == "-123");
+  r = BigInteger(10).ToChars(buf, buf + 4, 37);
+  REQUIRE(r.ec == std::errc::invalid_argument);
+  r = BigInteger::Error().ToChars(buf, buf + 4, 10);
+  REQUIRE(r.ec == std::errc::invalid_argument);
+}
+
+TEST_CASE("csBICharsTests:  FromChars_Consumed") {
+  BigInteger big;
+  string_view s = "-1234567890123456789012345,next";
+  auto r = BigInteger::FromChars(s, big);
+  REQUIRE(r.ec == std::errc());
+  REQUIRE(r.ptr == s.data() + 26);
+  REQUIRE(big == BigInteger("-1234567890123456789012345", 10));
+  r = BigInteger::FromChars("FFfF", big, 16);
+  REQUIRE(r.ec == std::errc());
+  REQUIRE(big == BigInteger(65535));
+  string_view bin = "-1000000002";
+  r = BigInteger::FromChars(bin, big, 2);
+  REQUIRE(r.ptr == bin.data() + 10);
+  REQUIRE(big == BigInteger(-256));
+  r = BigInteger::FromChars("-0", big);
+  REQUIRE(big == BigInteger::Zero());
+  // failures keep value
+  big = BigInteger(7);
+  string_view bad = "-x1";
+  r = BigInteger::FromChars(bad, big);
+  REQUIRE(r.ec == std::errc::invalid_argument);
+  REQUIRE(r.ptr == bad.data());
+  REQUIRE(big == BigInteger(7));
+  REQUIRE(BigInteger::FromChars("+1", big).ec == std::errc::invalid_argument);
+  REQUIRE(BigInteger::FromChars("", big).ec == std::errc::invalid_argument);
+}
+
+TEST_CASE("csBICharsTests:  FromChars_Decimal_Runs") {
+  // invalid char on every position around 8-digit blocks
+  for (size_t len = 1; len <= 40; len++) {
+    string s(len, '7');
+    for (size_t bad = 0; bad < len; bad++) {
+      string t = s;
+      t[bad] = (bad % 2) ? ':' : '/';  // neighbours of '0'..'9'
+      BigInteger big;
+      auto r = BigInteger::FromChars(t, big);
+      if (bad == 0) {
+        REQUIRE(r.ec == std::errc::invalid_argument);
+      } else {
+        REQUIRE(r.ptr == t.data() + bad);
+        REQUIRE(big == BigInteger(s.substr(0, bad), 10));
+      }
+    }
+  }
+}
+
+TEST_CASE("csBICharsTests:  FromChars_Long_Decimal") {
+  // above horner limit: combined by halves with karatsuba
+  string s;
+  for (int i = 0; i < 1500; i++) s.push_back('0' + (i * 7 + i / 13) % 10);
+  BigInteger expected = BigInteger::Zero();
+  for (size_t i = 0; i < s.length(); i += 9)
+    expected = expected * BigInteger::Pow(BigInteger(10), s.substr(i, 9).length()) +
+               BigInteger(std::stoi(s.substr(i, 9)));
+  BigInteger big;
+  REQUIRE(BigInteger::FromChars(s, big).ec == std::errc());
+  REQUIRE(big == expected);
+  REQUIRE(BigInteger(s, 10) == expected);
+  REQUIRE(BigInteger("-" + s, 10) == -expected);
+  string p10 = "1" + string(3000, '0');
+  REQUIRE(BigInteger(p10, 10) == BigInteger::Pow(BigInteger(10), 3000));
+  REQUIRE(csBIToChars(BigInteger(p10, 10), 10) == p10);
+}
+
+TEST_CASE("csBICharsTests:  ToChars_Long") {
+  // above DEC_SPLIT chunks: split by halves over cached powers
+  for (int digits : {1500, 6000}) {
+    BigInteger p10 = BigInteger::Pow(BigInteger(10), digits);
+    BigInteger big = p10 / BigInteger(7);
+    for (const BigInteger& v : {p10, p10 - BigInteger::One(), big, -big}) {
+      vector<char> buf(digits + 2);
+      auto r = v.ToChars(buf.data(), buf.data() + buf.size(), 10);
+      REQUIRE(r.ec == std::errc());
+      REQUIRE(string(buf.data(), r.ptr) == v.ToString(10));
+    }
+    vector<char> buf(digits * 2);
+    auto r = big.ToChars(buf.data(), buf.data() + buf.size(), 7);
+    REQUIRE(r.ec == std::errc());
+    BigInteger back;
+    REQUIRE(BigInteger::FromChars(string_view(buf.data(), r.ptr - buf.data()),
+                                  back, 7)
+                .ec == std::errc());
+    REQUIRE(back == big);
+  }
+}
+
+TEST_CASE("csBICharsTests:  Radix_Digits") {
+  REQUIRE(csBIToChars(BigInteger(35), 36) == "z");
+  REQUIRE(csBIToChars(BigInteger(-36), 36) == "-10");
+  REQUIRE(csBIToChars(BigInteger(8), 8) == "10");
+  REQUIRE(csBIToChars(BigInteger(511), 8) == "777");
+  REQUIRE(csBIToChars(BigInteger(1023), 32) == "vv");
+  REQUIRE(csBIToChars(BigInteger(80), 3) == "2222");
+  REQUIRE(csBIToChars(BigInteger::Zero(), 58) == "1");
+  REQUIRE(csBIToChars(BigInteger(57), 58) == "z");
+  REQUIRE(csBIToChars(BigInteger(58), 58) == "21");
+  REQUIRE(csBIToChars(BigInteger::Zero(), 64) == "A");
+  REQUIRE(csBIToChars(BigInteger(4095), 64) == "__");
+  REQUIRE(csBIToChars(BigInteger(62 * 64 + 1), 64) == "-B");
+  char buf[8];
+  REQUIRE(BigInteger(-1).ToChars(buf, buf + 8, 64).ec ==
+          std::errc::invalid_argument);
+  REQUIRE(BigInteger(1).ToChars(buf, buf + 8, 37).ec ==
+          std::errc::invalid_argument);
+  REQUIRE(BigInteger::Parse("Zz", 36) == BigInteger(35 * 36 + 35));
+  REQUIRE(BigInteger::Parse("-2222", 3) == BigInteger(-80));
+  REQUIRE(BigInteger::Parse("-B", 64) == BigInteger(62 * 64 + 1));
+  REQUIRE(BigInteger::Parse("0", 58) == BigInteger::Error());  // not in alphabet
+  REQUIRE(BigInteger::Parse("12x", 10) == BigInteger::Error());
+  REQUIRE(BigInteger::Parse("", 10) == BigInteger::Error());
+}
+
+TEST_CASE("csBICharsTests:  ToString_Radix") {
+  REQUIRE(BigInteger(10).ToString(2) == "1010");
+  REQUIRE(BigInteger(256).ToString(2) == "100000000");
+  REQUIRE(BigInteger(128).ToString(2) == "010000000");
+  REQUIRE(BigInteger(-1).ToString(2) == "11111111");
+  REQUIRE(BigInteger(256).ToString(16) == "0x0100");
+  REQUIRE(BigInteger(-1).ToString(16) == "0xff");
+  REQUIRE(BigInteger(-100).ToString(7) == "-202");
+  REQUIRE(BigInteger(255).ToString(4) == "3333");
+  BigInteger big = BigInteger::Pow(BigInteger(10), 40);
+  REQUIRE(BigInteger::Parse(big.ToString(58), 58) == big);
+  REQUIRE(BigInteger::Parse(big.ToString(64), 64) == big);
+}
+
+TEST_CASE("csBICharsTests:  Round_Trip") {
+  BigInteger big = BigInteger::Factorial(200);
+  for (int base : {2, 3, 4, 7, 8, 10, 16, 32, 36, 58, 64}) {
+    for (const BigInteger& v : {big, -big, big + BigInteger::One()}) {
+      if ((base == 64) && (v < BigInteger::Zero())) continue;
+      BigInteger back;
+      string s = csBIToChars(v, base);
+      auto r = BigInteger::FromChars(s, back, base);
+      REQUIRE(r.ec == std::errc());
+      REQUIRE(r.ptr == s.data() + s.size());
+      REQUIRE(back == v);
+    }
+  }
+}
+
+TEST_CASE("csBICharsTests:  WriteDecimal_Blocks") {
+  // small blocks: deep divide and conquer with zero padded blocks
+  vector<BigInteger> values = {
+      BigInteger::Zero(), BigInteger(-7), BigInteger::Pow(BigInteger(10), 160),
+      BigInteger::Pow(BigInteger(10), 161) - BigInteger::One(),
+      -(BigInteger::Pow(BigInteger(10), 97) + BigInteger(5)),
+      BigInteger::Factorial(120)};
+  for (const BigInteger& v : values) {
+    for (size_t chunk : {1, 3, 16, 8192}) {
+      std::ostringstream os;
+      v.WriteDecimal(os, chunk);
+      REQUIRE(os.str() == v.ToString(10));
+    }
+    std::ostringstream dec, hex;
+    dec << v;
+    hex << std::hex << v;
+    REQUIRE(dec.str() == v.ToString(10));
+    REQUIRE(hex.str() == v.ToString(16));
+  }
+  std::ostringstream err;
+  err << BigInteger::Error();
+  REQUIRE(err.str() == "");
+}
+
+TEST_CASE("csBICharsTests:  WriteHex_Long") {
+  // > 4KB of hex
+  BigInteger big = -BigInteger::Parse("1" + string(5000, '0') + "f", 16);
+  std::ostringstream os;
+  big.WriteHex(os);
+  REQUIRE(os.str() == big.ToString(16));
+}
+
+TEST_CASE("csBICharsTests:  DecimalString") {
+  REQUIRE(BigInteger(12345678).ToDecimalString(3) == "12345.678");
+  REQUIRE(BigInteger(12345000).ToDecimalString(3) == "12345");
+  REQUIRE(BigInteger(12345600).ToDecimalString(3) == "12345.6");
+  REQUIRE(BigInteger(-1).ToDecimalString(3) == "-0.001");
+  REQUIRE(BigInteger(-1000).ToDecimalString(3) == "-1");
+  REQUIRE(BigInteger::Zero().ToDecimalString(8) == "0");
+  REQUIRE(BigInteger(42).ToDecimalString(0) == "42");
+  REQUIRE(BigInteger::Error().ToDecimalString(2) == "");
+  BigInteger big = BigInteger::Parse("1" + string(40, '0') + "5");
+  REQUIRE(big.ToDecimalString(8) == "1" + string(33, '0') + ".00000005");
+  REQUIRE(BigInteger(123).ToDecimalString(3) == "0.123");
+  REQUIRE(BigInteger(-5).ToDecimalString(1) == "-0.5");
+  REQUIRE(BigInteger(5).ToDecimalString(1000) == "0." + string(999, '0') + "5");
+}
+
+TEST_CASE("csBICharsTests:  ParseDecimal") {
+  REQUIRE(BigInteger::ParseDecimal("12345.678", 3) == BigInteger(12345678));
+  REQUIRE(BigInteger::ParseDecimal("12345.6", 3) == BigInteger(12345600));
+  REQUIRE(BigInteger::ParseDecimal("12345", 3) == BigInteger(12345000));
+  REQUIRE(BigInteger::ParseDecimal("-0.001", 3) == BigInteger(-1));
+  REQUIRE(BigInteger::ParseDecimal("-.5", 1) == BigInteger(-5));
+  REQUIRE(BigInteger::ParseDecimal("7.", 0) == BigInteger(7));
+  REQUIRE(BigInteger::ParseDecimal(".000", 0) == BigInteger::Zero());
+  // extra fractional zeroes are fine, other digits exceed precision
+  REQUIRE(BigInteger::ParseDecimal("1.2300", 2) == BigInteger(123));
+  REQUIRE(BigInteger::ParseDecimal("1.234", 2) == BigInteger::Error());
+  REQUIRE(BigInteger::ParseDecimal("", 2) == BigInteger::Error());
+  REQUIRE(BigInteger::ParseDecimal("-.", 2) == BigInteger::Error());
+  REQUIRE(BigInteger::ParseDecimal("1.2.3", 2) == BigInteger::Error());
+  REQUIRE(BigInteger::ParseDecimal("1e5", 2) == BigInteger::Error());
+  REQUIRE(BigInteger::ParseDecimal("+1", 2) == BigInteger::Error());
+  REQUIRE(BigInteger::ParseDecimal("1", -1) == BigInteger::Error());
+  for (const char* str : {"0.5", "-98765.4321", "1000", "-0.00000001"})
+    REQUIRE(BigInteger::ParseDecimal(str, 8).ToDecimalString(8) == str);
+  // scaled by a power of ten, not by padding the digits
+  REQUIRE(BigInteger::ParseDecimal("-1.5", 100000) ==
+          BigInteger(-15) * BigInteger::PowerOf10(99999));
+  REQUIRE(BigInteger::ParseDecimal("0", 100000) == BigInteger::Zero());
+}
+
+TEST_CASE("csBICharsTests:  PowerOf10") {
+  REQUIRE(BigInteger::PowerOf10(-1) == BigInteger::Error());
+  REQUIRE(BigInteger::PowerOf10(0) == BigInteger::One());
+  REQUIRE(BigInteger::PowerOf10(1) == BigInteger(10));
+  for (int n : {18, 19, 20, 38, 39, 100, 1000, 4567})
+    REQUIRE(BigInteger::PowerOf10(n) ==
+            BigInteger::Parse("1" + string(n, '0')));
+}
+
+TEST_CASE("csBICharsTests:  PowerOf10_Threads") {
+  // concurrent readers and writers of the shared cache
+  BigInteger expected = BigInteger::Parse("1" + string(20000, '0'));
+  std::vector<int> ok(8, 0);
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < ok.size(); t++)
+    workers.emplace_back([&ok, &expected, t]() {
+      string digits(3000 + 100 * t, '6');
+      BigInteger big = BigInteger::Parse(digits, 7);
+      ok[t] = (BigInteger::PowerOf10(20000) == expected) &&
+              (big.ToString(7) == digits);
+    });
+  for (auto& w : workers) w.join();
+  REQUIRE(ok == std::vector<int>(8, 1));
+}
+
+#endif
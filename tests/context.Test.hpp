@@ -0,0 +1,172 @@
+#include <catch2/catch_amalgamated.hpp>
+
+// system
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// core includes
+#ifdef TEST_CSBIGINTEGER_LIB
+#include <csbiginteger/csBigIntegerLibClass.hpp>
+using namespace csbigintegerlib;
+#else
+#include <csbiginteger/BigInteger.h>
+#include <csbiginteger/BigIntegerContext.hpp>
+using namespace csbiginteger;
+#endif
+
+using namespace std;
+
+#ifndef TEST_CSBIGINTEGER_LIB
+
+TEST_CASE("csBIContextTests:  Pow_Progress_And_Cancel") {
+  BigInteger x = BigInteger(-7);
+  BigInteger expected = BigInteger::Pow(x, 300);
+  BigIntegerContext ctx;
+  size_t last = 0, total = 0;
+  ctx.progress = [&](const char* phase, size_t done, size_t all) {
+    REQUIRE(string(phase) == "pow");
+    REQUIRE(done >= last);
+    last = done;
+    total = all;
+  };
+  {
+    BigIntegerContext::Scope scope(&ctx);
+    REQUIRE(BigInteger::Pow(x, 300) == expected);
+    REQUIRE(total == 9);  // bits of 300
+    REQUIRE(last == 9);
+    last = 0;
+    REQUIRE(BigInteger::Pow(x, 0) == BigInteger::One());
+  }
+  REQUIRE(BigIntegerContext::Current() == nullptr);
+  // cancelled half way
+  ctx.progress = [&ctx](const char*, size_t done, size_t) {
+    if (done == 4) ctx.Cancel();
+  };
+  BigIntegerContext::Scope scope(&ctx);
+  REQUIRE(BigInteger::Pow(x, 300) == BigInteger::Error());
+}
+
+TEST_CASE("csBIContextTests:  Conversions_Cancel") {
+  string digits(20000, '7');
+  BigInteger big = BigInteger::Parse(digits);
+  vector<char> buf(2 * digits.size());
+  BigIntegerContext ctx;
+  vector<string> phases;
+  ctx.progress = [&](const char* phase, size_t done, size_t total) {
+    if (phases.empty() || (phases.back() != phase)) phases.push_back(phase);
+    REQUIRE(done <= total);
+  };
+  {
+    BigIntegerContext::Scope scope(&ctx);
+    BigInteger v;
+    REQUIRE(BigInteger::FromChars(digits, v).ec == std::errc());
+    REQUIRE(v == big);
+    auto r = big.ToChars(buf.data(), buf.data() + buf.size(), 7);
+    REQUIRE(r.ec == std::errc());
+    REQUIRE(BigInteger::FromChars(string_view(buf.data(), r.ptr - buf.data()),
+                                  v, 7)
+                .ec == std::errc());
+    REQUIRE(v == big);
+    // small value (engine division of hand builds is slow)
+    ostringstream os;
+    BigInteger::Parse(digits.substr(0, 200)).WriteDecimal(os, 50);
+    REQUIRE(os.str() == digits.substr(0, 200));
+  }
+  REQUIRE(phases == vector<string>{"from_chars", "to_chars", "from_chars",
+                                   "write_decimal"});
+  // cancelled: nothing changed, stream failed
+  ctx.Cancel();
+  BigIntegerContext::Scope scope(&ctx);
+  BigInteger v = BigInteger::One();
+  REQUIRE(BigInteger::FromChars(digits, v).ec == std::errc::operation_canceled);
+  REQUIRE(v == BigInteger::One());
+  REQUIRE(big.ToChars(buf.data(), buf.data() + buf.size()).ec ==
+          std::errc::operation_canceled);
+  ostringstream os;
+  big.WriteDecimal(os, 50);
+  REQUIRE(os.fail());
+  REQUIRE(os.str().size() <= 50);
+  REQUIRE(BigInteger::PowerOf10(30000) == BigInteger::Error());
+}
+
+// value of 'n' bytes (pseudo random, top byte set)
+static BigInteger csBIContextValue(size_t n, unsigned seed) {
+  cs_vbyte v(n);
+  for (size_t i = 0; i < n; i++) {
+    seed = seed * 1103515245u + 12345u;
+    v[i] = static_cast<cs_byte>(seed >> 16);
+  }
+  v[n - 1] = 0x5a;
+  return BigInteger(v);
+}
+
+TEST_CASE("csBIContextTests:  Mul_Div_Polled") {
+  // limb kernels under a context give the engine results (all signs)
+  BigInteger a = csBIContextValue(4400, 1), b = csBIContextValue(2200, 2);
+  BigInteger p = a * b;  // engine
+  BigIntegerContext ctx;
+  BigIntegerContext::Scope scope(&ctx);
+  for (int s = 0; s < 4; s++) {
+    bool na = (s & 1) != 0, nb = (s & 2) != 0;
+    BigInteger x = na ? -a : a, y = nb ? -b : b;
+    REQUIRE(x * y == ((na != nb) ? -p : p));
+    // truncated division: remainder below divisor, with sign of dividend
+    BigInteger q = x / y, r = x % y;
+    REQUIRE(q * y + r == x);
+    REQUIRE(BigInteger::Abs(r) < b);
+    REQUIRE((r.IsZero() || ((r < BigInteger::Zero()) == na)));
+    REQUIRE((q < BigInteger::Zero()) == (na != nb));
+  }
+  // quotient of several blocks
+  BigInteger d = csBIContextValue(2050, 3);
+  BigInteger x = p * a + BigInteger(12345);
+  REQUIRE(x / d * d + x % d == x);
+  REQUIRE(x % d < d);
+  REQUIRE(x / p == a);
+  REQUIRE(x % p == BigInteger(12345));
+  REQUIRE(a / a == BigInteger::One());
+  REQUIRE(a % a == BigInteger::Zero());
+  REQUIRE(b / a == BigInteger::Zero());
+  REQUIRE(b % a == b);
+}
+
+TEST_CASE("csBIContextTests:  Mul_Div_Cancel") {
+  // multi-megabit operations, cancelled while running
+  BigInteger a = csBIContextValue(size_t{1} << 19, 4);
+  BigInteger b = csBIContextValue(size_t{1} << 19, 5);
+  BigInteger x = csBIContextValue(size_t{1} << 20, 6);
+  for (int op = 0; op < 2; op++) {
+    BigIntegerContext ctx;
+    BigIntegerContext::Scope scope(&ctx);
+    thread canceller([&ctx]() {
+      this_thread::sleep_for(chrono::milliseconds(10));
+      ctx.Cancel();
+    });
+    auto t0 = chrono::steady_clock::now();
+    BigInteger r = (op == 0) ? a * b : x / b;
+    auto elapsed = chrono::steady_clock::now() - t0;
+    canceller.join();
+    REQUIRE(r == BigInteger::Error());
+    REQUIRE(elapsed >= chrono::milliseconds(10));  // was running
+    REQUIRE(elapsed < chrono::seconds(10));
+  }
+}
+
+TEST_CASE("csBIContextTests:  Shared_Powers_Not_Cancelled") {
+  // powers filled while a cancelled context is installed stay valid
+  BigIntegerContext ctx;
+  ctx.Cancel();
+  {
+    BigIntegerContext::Scope scope(&ctx);
+    BigInteger::PowerOf10(123456);
+  }
+  BigInteger p = BigInteger::PowerOf10(123456);
+  string s = p.ToString(10);
+  REQUIRE(s.size() == 123457);
+  REQUIRE(s == "1" + string(123456, '0'));
+}
+
+#endif
@@ -1,8 +1,20 @@
 
 // collection of 'csBigInteger' project tests
 
+#include "accumulator.Test.hpp"
 #include "arithmetics.Test.hpp"
+#include "async.Test.hpp"
+#include "chars.Test.hpp"
+#include "context.Test.hpp"
+#include "divisor.Test.hpp"
+#include "expression.Test.hpp"
+#include "format.Test.hpp"
 #include "helper.Test.hpp"
+#include "parser.Test.hpp"
+#include "reduction.Test.hpp"
+#include "ring.Test.hpp"
 #include "serialize.Test.hpp"
+#include "shifted.Test.hpp"
+#include "stringcache.Test.hpp"
 
 // good
@@ -0,0 +1,138 @@
+#include <catch2/catch_amalgamated.hpp>
+
+// system
+#include <thread>
+#include <vector>
+
+// core includes
+#ifdef TEST_CSBIGINTEGER_LIB
+#include <csbiginteger/csBigIntegerLibClass.hpp>
+using namespace csbigintegerlib;
+#else
+#include <csbiginteger/BigInteger.h>
+#include <csbiginteger/BigIntegerDivisor.hpp>
+using namespace csbiginteger;
+#endif
+
+using namespace std;
+
+#ifndef TEST_CSBIGINTEGER_LIB
+
+// divisors of one limb and several limbs (2^64 is the Barrett edge case
+// d = B^(n-1)), and dividends of several sizes and signs
+static vector<BigInteger> divisorTestValues() {
+  vector<BigInteger> vals = {
+      BigInteger(1),
+      BigInteger(3),
+      BigInteger(10),
+      BigInteger(-7),
+      BigInteger(1000003),
+      BigInteger::PowerOf10(9),
+      BigInteger::PowerOf10(18),
+      BigInteger::PowerOf10(19),
+      BigInteger::One() << 63,
+      (BigInteger::One() << 64) - BigInteger::One(),
+      BigInteger::One() << 64,
+      -(BigInteger::One() << 64),
+      (BigInteger::One() << 64) + BigInteger::One(),
+      BigInteger::PowerOf10(30),
+      (BigInteger::One() << 255) - BigInteger(19),
+      -((BigInteger::One() << 255) - BigInteger(19)),
+      BigInteger::One() << 128,
+      BigInteger::PowerOf10(77) + BigInteger(12345),
+      (BigInteger::One() << 2200) - BigInteger(1),
+      BigInteger::PowerOf10(700) / BigInteger(7)};
+  return vals;
+}
+
+TEST_CASE("csBIDivisorTests:  Matches_Operators") {
+  vector<BigInteger> vals = divisorTestValues();
+  vector<BigInteger> factors = {BigInteger(1), BigInteger(-3),
+                                (BigInteger::One() << 64) + BigInteger::One(),
+                                BigInteger::PowerOf10(30)};
+  for (const BigInteger& dv : vals) {
+    BigIntegerDivisor div(dv);
+    REQUIRE(!div.IsError());
+    REQUIRE(div.Value() == dv);
+    for (const BigInteger& a : vals) {
+      for (const BigInteger& b : factors) {
+        BigInteger x = a * b + BigInteger(17);
+        for (const BigInteger& y : {x, -x, x - BigInteger(18), a, -b}) {
+          BigInteger r;
+          BigInteger q = div.DivRem(y, r);
+          REQUIRE(q == y / dv);
+          REQUIRE(r == y % dv);
+          REQUIRE(div.Divide(y) == q);
+          REQUIRE(div.Remainder(y) == r);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("csBIDivisorTests:  Multiples_And_Zero") {
+  for (const BigInteger& dv : divisorTestValues()) {
+    BigIntegerDivisor div(dv);
+    for (int k = 0; k < 5; k++) {
+      BigInteger m = BigInteger::PowerOf10(k * 10) + BigInteger(k);
+      BigInteger x = dv * m;
+      BigInteger r = BigInteger::One();
+      REQUIRE(div.DivRem(x, r) == m);
+      REQUIRE(r == BigInteger::Zero());
+      REQUIRE(div.Remainder(x - BigInteger::Abs(dv)) == BigInteger::Zero());
+      // one below a positive multiple: largest remainder
+      if (dv.Sign() > 0)
+        REQUIRE(div.Remainder(x - BigInteger::One()) ==
+                dv - BigInteger::One());
+    }
+    REQUIRE(div.Divide(BigInteger::Zero()) == BigInteger::Zero());
+  }
+}
+
+TEST_CASE("csBIDivisorTests:  Above_Max_Limbs") {
+  BigInteger dv = (BigInteger::One() << 4200) - BigInteger(3);  // 66 limbs
+  BigIntegerDivisor div(dv);
+  BigInteger m = BigInteger::PowerOf10(40) + BigInteger(9);
+  BigInteger x = dv * m;
+  for (const BigInteger& y : {x + BigInteger(5), -x - dv + BigInteger::One(),
+                              BigInteger(12345), -dv}) {
+    BigInteger r;
+    REQUIRE(div.DivRem(y, r) == y / dv);
+    REQUIRE(r == y % dv);
+  }
+}
+
+TEST_CASE("csBIDivisorTests:  Errors") {
+  REQUIRE(BigIntegerDivisor(BigInteger::Zero()).IsError());
+  REQUIRE(BigIntegerDivisor(BigInteger::Error()).IsError());
+  BigInteger r;
+  REQUIRE(BigIntegerDivisor(BigInteger::Zero()).DivRem(BigInteger(5), r) ==
+          BigInteger::Error());
+  REQUIRE(r == BigInteger::Error());
+  REQUIRE(BigIntegerDivisor(BigInteger(3)).Divide(BigInteger::Error()) ==
+          BigInteger::Error());
+}
+
+TEST_CASE("csBIDivisorTests:  Shared_By_Threads") {
+  const BigIntegerDivisor small(BigInteger::PowerOf10(18));
+  const BigIntegerDivisor large((BigInteger::One() << 255) - BigInteger(19));
+  vector<int> ok(4, 0);
+  vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&, t]() {
+      BigInteger x = BigInteger::PowerOf10(60) + BigInteger(t);
+      for (int i = 0; i < 50; i++) {
+        x = x * BigInteger(1000003) + BigInteger(i);
+        BigInteger r1, r2;
+        BigInteger q1 = small.DivRem(x, r1);
+        BigInteger q2 = large.DivRem(x, r2);
+        ok[t] += (q1 * small.Value() + r1 == x) && (r1 < small.Value()) &&
+                 (q2 * large.Value() + r2 == x) && (r2 < large.Value());
+      }
+    });
+  }
+  for (std::thread& th : threads) th.join();
+  for (int t = 0; t < 4; t++) REQUIRE(ok[t] == 50);
+}
+
+#endif
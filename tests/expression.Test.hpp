@@ -0,0 +1,133 @@
+#include <catch2/catch_amalgamated.hpp>
+
+// system
+#include <string>
+#include <vector>
+
+// core includes
+#ifdef TEST_CSBIGINTEGER_LIB
+#include <csbiginteger/csBigIntegerLibClass.hpp>
+using namespace csbigintegerlib;
+#else
+#include <csbiginteger/BigInteger.h>
+#include <csbiginteger/BigIntegerExpression.hpp>
+using namespace csbiginteger;
+#endif
+
+using namespace std;
+
+#ifndef TEST_CSBIGINTEGER_LIB
+
+// compiled infix expression (must succeed)
+static BigIntegerExpression csBIExpr(const string& src,
+                                     const vector<string>& vars) {
+  BigIntegerExpression expr;
+  auto r = BigIntegerExpression::Compile(src, vars, expr);
+  REQUIRE(r.ec == std::errc());
+  return expr;
+}
+
+TEST_CASE("csBIExpressionTests:  Infix_Precedence") {
+  vector<string> vars{"a", "b"};
+  vector<BigInteger> args{BigInteger(7), BigInteger(-3)};
+  REQUIRE(csBIExpr("a + b * 2", vars).Evaluate(args) == BigInteger(1));
+  REQUIRE(csBIExpr("(a + b) * 2", vars).Evaluate(args) == BigInteger(8));
+  REQUIRE(csBIExpr("a - b - 1", vars).Evaluate(args) == BigInteger(9));
+  REQUIRE(csBIExpr("-a % 4", vars).Evaluate(args) == BigInteger(-3));
+  REQUIRE(csBIExpr("1 << a + 1", vars).Evaluate(args) == BigInteger(256));
+  REQUIRE(csBIExpr("abs(b) + min(a, b) * max(a, b)", vars).Evaluate(args) ==
+          BigInteger(-18));
+  REQUIRE(csBIExpr("pow(a, 3) / 0x10", vars).Evaluate(args) == BigInteger(21));
+  REQUIRE(csBIExpr("a / (b + 3)", vars).Evaluate(args) == BigInteger::Error());
+  REQUIRE(csBIExpr("a", vars).Evaluate(args) == BigInteger(7));
+  REQUIRE(csBIExpr("a", vars).Evaluate({BigInteger(1)}) == BigInteger::Error());
+}
+
+TEST_CASE("csBIExpressionTests:  Compile_Errors") {
+  BigIntegerExpression expr;
+  string src = "a + * b";
+  auto r = BigIntegerExpression::Compile(src, {"a", "b"}, expr);
+  REQUIRE(r.ec == std::errc::invalid_argument);
+  REQUIRE(r.ptr == src.data() + 4);  // at "*"
+  REQUIRE(BigIntegerExpression::Compile("a + c", {"a"}, expr).ec ==
+          std::errc::invalid_argument);
+  REQUIRE(BigIntegerExpression::Compile("min(a)", {"a"}, expr).ec ==
+          std::errc::invalid_argument);
+  REQUIRE(BigIntegerExpression::Compile("(a", {"a"}, expr).ec ==
+          std::errc::invalid_argument);
+  REQUIRE(BigIntegerExpression::CompileRPN("a +", {"a"}, expr).ec ==
+          std::errc::invalid_argument);
+  REQUIRE(BigIntegerExpression::CompileRPN("a a", {"a"}, expr).ec ==
+          std::errc::invalid_argument);
+}
+
+TEST_CASE("csBIExpressionTests:  Folding_And_Registers") {
+  // constants are folded, shift amount becomes immediate
+  BigIntegerExpression expr = csBIExpr("x << (2 * 3 + 1)", {"x"});
+  REQUIRE(expr.Code().size() == 1);
+  REQUIRE(expr.Code()[0].useImm);
+  REQUIRE(expr.Code()[0].imm == 7);
+  REQUIRE(expr.Evaluate({BigInteger(1)}) == BigInteger(128));
+  // registers are reused once consumed
+  expr = csBIExpr("((a + b) * (a - b)) + ((a * b) - (b * b))", {"a", "b"});
+  REQUIRE(expr.Code().size() == 7);
+  REQUIRE(expr.Registers() <= 3);
+  REQUIRE(expr.Evaluate({BigInteger(5), BigInteger(2)}) == BigInteger(27));
+  // whole constant expression
+  expr = csBIExpr("pow(2, 10) - 24", {});
+  REQUIRE(expr.Code().empty());
+  REQUIRE(expr.Evaluate(vector<BigInteger>{}) == BigInteger(1000));
+}
+
+TEST_CASE("csBIExpressionTests:  Counts_Out_Of_Int32") {
+  // exponents and shift counts are never truncated to int32
+  vector<string> vars{"x", "n"};
+  BigInteger big = BigInteger::Parse("4294967298");  // 2^32 + 2
+  vector<BigInteger> args{BigInteger(3), big};
+  REQUIRE(csBIExpr("pow(x, n)", vars).Evaluate(args) == BigInteger::Error());
+  REQUIRE(csBIExpr("x << n", vars).Evaluate(args) == BigInteger::Error());
+  REQUIRE(csBIExpr("x >> n", vars).Evaluate(args) == BigInteger::Error());
+  REQUIRE(csBIExpr("x >> -n", vars).Evaluate(args) == BigInteger::Error());
+  REQUIRE(csBIExpr("pow(x, 4294967298)", vars).Evaluate(args) ==
+          BigInteger::Error());
+  REQUIRE(csBIExpr("pow(3, 4294967298)", {}).Evaluate(vector<BigInteger>{}) ==
+          BigInteger::Error());
+  args[1] = BigInteger(5);
+  REQUIRE(csBIExpr("pow(x, n)", vars).Evaluate(args) == BigInteger(243));
+  REQUIRE(csBIExpr("x << n", vars).Evaluate(args) == BigInteger(96));
+  REQUIRE(csBIExpr("(x << 9) >> n", vars).Evaluate(args) == BigInteger(48));
+}
+
+TEST_CASE("csBIExpressionTests:  RPN_Same_As_Infix") {
+  vector<string> vars{"a", "b", "c"};
+  BigIntegerExpression rpn;
+  auto r = BigIntegerExpression::CompileRPN("a b + 2 * neg c max", vars, rpn);
+  REQUIRE(r.ec == std::errc());
+  BigIntegerExpression infix = csBIExpr("max(-((a + b) * 2), c)", vars);
+  for (int a = -3; a <= 3; a++) {
+    vector<BigInteger> args{BigInteger(a), BigInteger(a * 5), BigInteger(-7)};
+    REQUIRE(rpn.Evaluate(args) == infix.Evaluate(args));
+  }
+}
+
+TEST_CASE("csBIExpressionTests:  Columns_Threads") {
+  BigIntegerExpression expr = csBIExpr("a * rate / 10000 + bonus",
+                                       {"a", "rate", "bonus"});
+  size_t n = 5000;
+  vector<vector<BigInteger>> cols(3);
+  for (size_t i = 0; i < n; i++) {
+    cols[0].push_back(BigInteger(static_cast<cs_int64>(i) * 1000003));
+    cols[1].push_back(BigInteger(static_cast<cs_int32>(i % 97)));
+    cols[2].push_back(BigInteger(static_cast<cs_int32>(i % 5)));
+  }
+  vector<BigInteger> serial = expr.Evaluate(cols);
+  vector<BigInteger> parallel = expr.Evaluate(cols, 4);
+  REQUIRE(serial.size() == n);
+  REQUIRE(serial == parallel);
+  cs_int64 i = 4321;
+  REQUIRE(serial[i] == BigInteger(i * 1000003 * (i % 97) / 10000 + (i % 5)));
+  cols[2].pop_back();
+  REQUIRE(expr.Evaluate(cols).empty());
+}
+
+#endif
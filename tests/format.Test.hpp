@@ -0,0 +1,66 @@
+#include <catch2/catch_amalgamated.hpp>
+
+// system
+#include <iterator>
+#include <string>
+#include <string_view>
+
+// core includes
+#ifdef TEST_CSBIGINTEGER_LIB
+#include <csbiginteger/csBigIntegerLibClass.hpp>
+using namespace csbigintegerlib;
+#else
+#include <csbiginteger/BigInteger.h>
+#include <csbiginteger/BigIntegerFormat.hpp>
+using namespace csbiginteger;
+#endif
+
+using namespace std;
+
+#ifndef TEST_CSBIGINTEGER_LIB
+
+// same as formatter with given spec ("#x" for "{:#x}"), or "invalid"
+static string csBIFormat(const BigInteger& big, string_view spec) {
+  BigIntegerFormatSpec fs;
+  std::from_chars_result r = fs.parse(spec.data(), spec.data() + spec.size());
+  if (r.ec != std::errc()) return "invalid";
+  string s;
+  fs.write(big, std::back_inserter(s));
+  return s;
+}
+
+TEST_CASE("csBIFormatTests:  Types") {
+  BigInteger x(-1234567);
+  REQUIRE(csBIFormat(x, "") == "-1234567");
+  REQUIRE(csBIFormat(x, "d") == "-1234567");
+  REQUIRE(csBIFormat(x, "x") == "-12d687");
+  REQUIRE(csBIFormat(x, "#X") == "-0X12D687");
+  REQUIRE(csBIFormat(BigInteger(5), "#b") == "0b101");
+  REQUIRE(csBIFormat(BigInteger(8), "#o") == "010");
+  REQUIRE(csBIFormat(BigInteger::Zero(), "#x") == "0x0");
+  REQUIRE(csBIFormat(BigInteger(42), "+") == "+42");
+  REQUIRE(csBIFormat(BigInteger(42), " ") == " 42");
+  REQUIRE(csBIFormat(x, "q") == "invalid");
+  REQUIRE(csBIFormat(x, ",x") == "invalid");
+  REQUIRE(csBIFormat(x, "10dd") == "invalid");
+}
+
+TEST_CASE("csBIFormatTests:  Width_Fill_Grouping") {
+  BigInteger x(-1234567);
+  REQUIRE(csBIFormat(x, "12") == "    -1234567");
+  REQUIRE(csBIFormat(x, "<12") == "-1234567    ");
+  REQUIRE(csBIFormat(x, "*^12") == "**-1234567**");
+  REQUIRE(csBIFormat(x, "012") == "-00001234567");
+  REQUIRE(csBIFormat(x, "4") == "-1234567");
+  REQUIRE(csBIFormat(x, ",") == "-1,234,567");
+  REQUIRE(csBIFormat(BigInteger(123456), ",") == "123,456");
+  REQUIRE(csBIFormat(x, ">12_") == "  -1_234_567");
+  REQUIRE(csBIFormat(BigInteger(0x1234567), "#_x") == "0x123_4567");
+  // large value (heap buffer)
+  BigInteger big = BigInteger::Parse(string(1000, '9'));
+  string s = csBIFormat(big, ",");
+  REQUIRE(s.size() == 1000 + 333);
+  REQUIRE(s.substr(0, 6) == "9,999,");
+}
+
+#endif
@@ -0,0 +1,86 @@
+#include <catch2/catch_amalgamated.hpp>
+
+// system
+#include <string>
+#include <string_view>
+
+// core includes
+#ifdef TEST_CSBIGINTEGER_LIB
+#include <csbiginteger/csBigIntegerLibClass.hpp>
+using namespace csbigintegerlib;
+#else
+#include <csbiginteger/BigInteger.h>
+#include <csbiginteger/BigIntegerParser.hpp>
+using namespace csbiginteger;
+#endif
+
+using namespace std;
+
+#ifndef TEST_CSBIGINTEGER_LIB
+
+// feed 'str' in chunks of 1, 2, 3, ... chars (cycling up to 'most')
+static BigInteger csBIParseChunks(string_view str, int base, size_t most) {
+  BigIntegerParser parser(base);
+  size_t len = 1;
+  for (size_t i = 0; i < str.size(); i += len, len = len % most + 1)
+    parser.feed(str.substr(i, len));
+  return parser.finish();
+}
+
+// pseudo-random digits of given radix
+static string csBIDigits(size_t n, int base) {
+  string s;
+  cs_uint32 seed = 12345;
+  for (size_t i = 0; i < n; i++) {
+    seed = seed * 1103515245u + 12345u;
+    s += Helper::digitChar((seed >> 16) % base, base);
+  }
+  return s;
+}
+
+TEST_CASE("csBIParserTests:  Small") {
+  BigIntegerParser parser;
+  REQUIRE(parser.feed("-12"));
+  REQUIRE(parser.feed("34"));
+  REQUIRE(parser.digits() == 4);
+  REQUIRE(parser.finish() == BigInteger(-1234));
+  // parser is reset by finish
+  REQUIRE(parser.feed("0"));
+  REQUIRE(parser.finish() == BigInteger::Zero());
+  REQUIRE(csBIParseChunks("-", 10, 1) == BigInteger::Error());
+  REQUIRE(csBIParseChunks("", 10, 1) == BigInteger::Error());
+  REQUIRE(csBIParseChunks("12a", 10, 2) == BigInteger::Error());
+  REQUIRE(csBIParseChunks("1-2", 10, 1) == BigInteger::Error());
+  REQUIRE(BigIntegerParser(37).finish() == BigInteger::Error());
+  REQUIRE(!BigIntegerParser(37).feed("1"));
+}
+
+TEST_CASE("csBIParserTests:  Decimal_Chunks") {
+  // several merge levels (48 chunks of 19 digits per block)
+  string str = "-" + csBIDigits(30000, 10);
+  BigInteger expected = BigInteger::Parse(str);
+  REQUIRE(expected != BigInteger::Error());
+  REQUIRE(csBIParseChunks(str, 10, 1) == expected);
+  REQUIRE(csBIParseChunks(str, 10, 64) == expected);
+  REQUIRE(csBIParseChunks(str, 10, 4096) == expected);
+  // leading zeroes
+  REQUIRE(csBIParseChunks(string(3000, '0') + "7", 10, 100) == BigInteger(7));
+}
+
+TEST_CASE("csBIParserTests:  Radix_Chunks") {
+  for (int base : {2, 7, 16, 36, 58, 64}) {
+    string str = csBIDigits(5000, base);
+    BigInteger expected = BigInteger::Parse(str, base);
+    REQUIRE(expected != BigInteger::Error());
+    REQUIRE(csBIParseChunks(str, base, 1) == expected);
+    REQUIRE(csBIParseChunks(str, base, 33) == expected);
+    if (base != 64)
+      REQUIRE(csBIParseChunks("-" + str, base, 7) ==
+              BigInteger::Parse("-" + str, base));
+  }
+  REQUIRE(csBIParseChunks("ff", 16, 1) == BigInteger(255));
+  REQUIRE(csBIParseChunks("-80", 16, 1) == BigInteger(-128));
+  REQUIRE(csBIParseChunks("101", 2, 1) == BigInteger(5));
+}
+
+#endif
@@ -0,0 +1,136 @@
+#include <catch2/catch_amalgamated.hpp>
+
+// system
+#include <limits>
+#include <vector>
+
+// core includes
+#ifdef TEST_CSBIGINTEGER_LIB
+#include <csbiginteger/csBigIntegerLibClass.hpp>
+using namespace csbigintegerlib;
+#else
+#include <csbiginteger/BigInteger.h>
+#include <csbiginteger/Reduction.hpp>
+using namespace csbiginteger;
+#endif
+
+using namespace std;
+
+#ifndef TEST_CSBIGINTEGER_LIB
+
+TEST_CASE("csBIReductionTests:  Sum_Empty_Is_Zero") {
+  vector<BigInteger> v;
+  REQUIRE(Sum(v) == BigInteger::Zero());
+  REQUIRE(Product(v) == BigInteger::One());
+}
+
+TEST_CASE("csBIReductionTests:  Sum_Mixed_Signs_Threads") {
+  // 5000 values crossing byte boundaries in both directions
+  vector<BigInteger> v;
+  cs_int64 expected = 0;
+  for (cs_int64 i = 0; i < 5000; i++) {
+    cs_int64 x = (i % 3 == 0 ? -1 : 1) * (i * 7919 + (i << 20));
+    v.push_back(BigInteger(x));
+    expected += x;
+  }
+  v.push_back(BigInteger(std::numeric_limits<cs_int64>::max()));
+  v.push_back(BigInteger(std::numeric_limits<cs_int64>::max()));
+  REQUIRE(Sum(v, 1) == Sum(v, 4));
+  REQUIRE(Sum(v, 4) - BigInteger(std::numeric_limits<cs_int64>::max()) -
+              BigInteger(std::numeric_limits<cs_int64>::max()) ==
+          BigInteger(expected));
+  REQUIRE(Sum(v.begin(), v.begin() + 2) == BigInteger(7919 + (1 << 20)));
+}
+
+TEST_CASE("csBIReductionTests:  Sum_Negative_Powers") {
+  vector<BigInteger> v = {BigInteger(-128), BigInteger(-128), BigInteger(255),
+                          BigInteger(1)};
+  REQUIRE(Sum(v) == BigInteger::Zero());
+  v.push_back(BigInteger(-1));
+  REQUIRE(Sum(v) == BigInteger::MinusOne());
+  v.push_back(BigInteger::Error());
+  REQUIRE(Sum(v) == BigInteger::Error());
+}
+
+TEST_CASE("csBIReductionTests:  Product_And_Dot") {
+  vector<BigInteger> v;
+  for (int i = 1; i <= 20; i++) v.push_back(BigInteger(i));
+  REQUIRE(Product(v).ToString(10) == "2432902008176640000");  // 20!
+  REQUIRE(Product(v, 4) == Product(v, 1));
+  vector<BigInteger> w(20, BigInteger(-2));
+  REQUIRE(Dot(v, w) == BigInteger(-420));
+  w.pop_back();
+  REQUIRE(Dot(v, w) == BigInteger::Error());
+}
+
+TEST_CASE("csBIReductionTests:  ProductTree_Factorial") {
+  REQUIRE(BigInteger::Factorial(-1) == BigInteger::Error());
+  REQUIRE(BigInteger::Factorial(0) == BigInteger::One());
+  REQUIRE(BigInteger::Factorial(20).ToString(10) == "2432902008176640000");
+  // compare to naive loop (crosses int64 packing and recursion)
+  BigInteger f = BigInteger::One();
+  vector<BigInteger> v;
+  for (int i = 1; i <= 300; i++) {
+    f = f * BigInteger(i);
+    v.push_back(BigInteger(i));
+    if ((i % 37 == 0) || (i == 21) || (i == 300))
+      REQUIRE(BigInteger::Factorial(i) == f);
+  }
+  REQUIRE(BigInteger::ProductTree(v) == f);
+  REQUIRE(BigInteger::ProductTree(v.begin(), v.end(), 4) == f);
+  REQUIRE(BigInteger::Factorial(300, 4) == f);
+  REQUIRE(BigInteger::Factorial(1000).ToString(10).length() == 2568);
+}
+
+TEST_CASE("csBIReductionTests:  Binomial_Pascal") {
+  REQUIRE(BigInteger::Binomial(-1, 0) == BigInteger::Error());
+  REQUIRE(BigInteger::Binomial(5, 6) == BigInteger::Zero());
+  REQUIRE(BigInteger::Binomial(5, -1) == BigInteger::Zero());
+  vector<BigInteger> row = {BigInteger::One()};
+  for (int n = 1; n <= 120; n++) {
+    vector<BigInteger> next(n + 1, BigInteger::One());
+    for (int k = 1; k < n; k++) next[k] = row[k - 1] + row[k];
+    row = next;
+    if (n % 17 == 0)
+      for (int k = 0; k <= n; k++) REQUIRE(BigInteger::Binomial(n, k) == row[k]);
+  }
+  REQUIRE(BigInteger::Binomial(120, 60, 4) == row[60]);
+  REQUIRE(BigInteger::Binomial(100, 50).ToString(10) ==
+          "100891344545564193334812497256");
+}
+
+// first engine calls of the process come from worker threads (cached
+// statics such as Error() must be built thread-safely). 'make run_test_tsan'
+// runs this case alone, in a fresh process, under ThreadSanitizer
+TEST_CASE("csBIReductionTests:  Parallel_First_Use") {
+  vector<BigInteger> v;
+  for (int i = 1; i <= 64; i++) v.push_back(BigInteger(i * 1000003));
+  BigInteger p = BigInteger::ProductTree(v, 4);
+  BigInteger f = BigInteger::Factorial(500, 4);
+  BigInteger b = BigInteger::Binomial(500, 200, 4);
+  BigInteger s = Sum(v, 4);
+  BigInteger d = Dot(v, v, 4);
+  // serial results
+  REQUIRE(p == BigInteger::ProductTree(v));
+  REQUIRE(f == BigInteger::Factorial(500));
+  REQUIRE(b == BigInteger::Binomial(500, 200));
+  REQUIRE(s == BigInteger(2080 * 1000003));
+  REQUIRE(d == Dot(v, v, 1));
+}
+
+#else
+
+TEST_CASE("csBIReductionTests:  C_Sum_Product_Dot_Packed") {
+  // packed little-endian: 300 (2c 01), -1 (ff), 5 (05)
+  cs_byte vb[] = {0x2c, 0x01, 0xff, 0x05};
+  cs_int32 sizes[] = {2, 1, 1};
+  cs_byte vr[16];
+  REQUIRE(csbiginteger_sum(vb, sizes, 3, 0, vr, 16) == 2);
+  REQUIRE(BigInteger(cs_vbyte(vr, vr + 2)) == BigInteger(304));
+  cs_int32 sz = csbiginteger_product(vb, sizes, 3, 0, vr, 16);
+  REQUIRE(BigInteger(cs_vbyte(vr, vr + sz)) == BigInteger(-1500));
+  sz = csbiginteger_dot(vb, sizes, vb, sizes, 3, 0, vr, 16);
+  REQUIRE(BigInteger(cs_vbyte(vr, vr + sz)) == BigInteger(90026));
+}
+
+#endif
@@ -0,0 +1,72 @@
+#include <catch2/catch_amalgamated.hpp>
+
+// system
+#include <vector>
+
+// core includes
+#ifdef TEST_CSBIGINTEGER_LIB
+#include <csbiginteger/csBigIntegerLibClass.hpp>
+using namespace csbigintegerlib;
+#else
+#include <csbiginteger/BigInteger.h>
+using namespace csbiginteger;
+#endif
+
+using namespace std;
+
+#ifdef TEST_CSBIGINTEGER_LIB
+
+// c
+#include <poll.h>
+
+TEST_CASE("csBIRingTests:  C_Ring_Submit_Complete") {
+  csbiginteger_ring* ring = csbiginteger_ring_create(50, 3);
+  REQUIRE(ring != nullptr);
+  // 64 slots: x * (x + 1) for x = 1000..1063, with tag x
+  int n = 64;
+  vector<cs_vbyte> a(n), b(n);
+  vector<cs_byte> out(n * 8);
+  for (int i = 0; i < n; i++) {
+    a[i] = BigInteger(1000 + i).ToByteArray();
+    b[i] = BigInteger(1001 + i).ToByteArray();
+    csbiginteger_sqe e{1000 + i, CSBIGINTEGER_OP_MUL, a[i].data(),
+                       static_cast<int>(a[i].size()), b[i].data(),
+                       static_cast<int>(b[i].size()), 0, &out[i * 8], 8};
+    REQUIRE(csbiginteger_ring_submit(ring, &e));
+  }
+  // full until some completion is reaped
+  csbiginteger_sqe pow{7, CSBIGINTEGER_OP_POW, a[0].data(), 2, nullptr, 0, 2,
+                       &out[0], 8};
+  REQUIRE(!csbiginteger_ring_submit(ring, &pow));
+  pollfd p{csbiginteger_ring_fd(ring), POLLIN, 0};
+  REQUIRE(::poll(&p, 1, 10000) == 1);
+  csbiginteger_cqe cqes[16];
+  int done = 0;
+  vector<bool> seen(n, false);
+  while (done < n) {
+    int k = csbiginteger_ring_wait(ring, cqes, 16, -1);
+    REQUIRE(k > 0);
+    for (int j = 0; j < k; j++) {
+      cs_int64 x = cqes[j].tag;
+      REQUIRE(((x >= 1000) && (x < 1000 + n)));
+      REQUIRE(!seen[x - 1000]);
+      seen[x - 1000] = true;
+      cs_byte* r = &out[(x - 1000) * 8];
+      REQUIRE(BigInteger(cs_vbyte(r, r + cqes[j].result)) ==
+              BigInteger(x * (x + 1)));
+    }
+    done += k;
+  }
+  REQUIRE(csbiginteger_ring_wait(ring, cqes, 16, 0) == 0);
+  // division by zero completes with error
+  cs_byte zero = 0x00;
+  csbiginteger_sqe div{9, CSBIGINTEGER_OP_DIV, a[0].data(), 2, &zero, 1, 0,
+                       &out[0], 8};
+  REQUIRE(csbiginteger_ring_submit(ring, &div));
+  REQUIRE(csbiginteger_ring_wait(ring, cqes, 16, 10000) == 1);
+  REQUIRE(cqes[0].tag == 9);
+  REQUIRE(cqes[0].result == 0);
+  csbiginteger_ring_destroy(ring);
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include <catch2/catch_amalgamated.hpp>
 
 // system
+#include <cmath>
 #include <limits>
 
 // core includes
@@ -50,6 +51,26 @@ TEST_CASE("csBIMemoryTests:  BigInteger_CopyTo_Bad") {
   REQUIRE(big.CopyTo(b, 1) == false);
 }
 
+#ifndef TEST_CSBIGINTEGER_LIB
+TEST_CASE("csBIMemoryTests:  BigInteger_MemoryResourceScope_arena") {
+  std::pmr::monotonic_buffer_resource arena;
+  BigInteger escaped;
+  {
+    BigInteger::MemoryResourceScope scope(&arena);
+    BigInteger big1(1000);
+    BigInteger big2 = big1 * BigInteger(1000) + BigInteger::One();
+    REQUIRE(big2.GetMemoryResource() == &arena);
+    REQUIRE(BigInteger::One().GetMemoryResource() == &arena);  // copy
+    REQUIRE(big2 == BigInteger(1000001));
+    escaped = BigInteger(big2, std::pmr::new_delete_resource());
+  }
+  REQUIRE(BigInteger::GetThreadMemoryResource() ==
+          std::pmr::get_default_resource());
+  REQUIRE(escaped.GetMemoryResource() == std::pmr::get_default_resource());
+  REQUIRE(escaped.ToString(10) == "1000001");
+}
+#endif
+
 // ===========================
 
 // from csBigInteger.js
@@ -1221,3 +1242,99 @@ TEST_CASE("csBISerializeTests: isUnsigned isBigEndian II") {
   // '1170523418943503455805726845660695966537054271385' and negative
   // counterpart!
 }
+
+#ifndef TEST_CSBIGINTEGER_LIB
+TEST_CASE("csBISerializeTests:  TryToInt64_TryToUInt64") {
+  cs_int64 i = 7;
+  cs_uint64 u = 7;
+  REQUIRE(BigInteger(-5).TryToInt64(i));
+  REQUIRE(i == -5);
+  BigInteger max64 = BigInteger::Parse("9223372036854775807");
+  BigInteger min64 = BigInteger::Parse("-9223372036854775808");
+  REQUIRE(max64.TryToInt64(i));
+  REQUIRE(i == std::numeric_limits<cs_int64>::max());
+  REQUIRE(min64.TryToInt64(i));
+  REQUIRE(i == std::numeric_limits<cs_int64>::min());
+  REQUIRE(!(max64 + 1).TryToInt64(i));
+  REQUIRE(!(min64 - 1).TryToInt64(i));
+  REQUIRE(!BigInteger::Error().TryToInt64(i));
+  REQUIRE(i == std::numeric_limits<cs_int64>::min());  // unchanged
+  REQUIRE((max64 + 1).TryToUInt64(u));
+  REQUIRE(u == cs_uint64{1} << 63);
+  BigInteger maxU64 = BigInteger::Parse("ffffffffffffffff", 16);
+  REQUIRE(maxU64.TryToUInt64(u));
+  REQUIRE(u == std::numeric_limits<cs_uint64>::max());
+  REQUIRE(!(maxU64 + 1).TryToUInt64(u));
+  REQUIRE(!BigInteger(-1).TryToUInt64(u));
+  REQUIRE(BigInteger::Zero().TryToUInt64(u));
+  REQUIRE(u == 0);
+  // engines take the same path
+  REQUIRE(min64.toLong() == std::numeric_limits<cs_int64>::min());
+  REQUIRE(BigInteger(-16773648).toInt() == -16773648);
+}
+
+TEST_CASE("csBISerializeTests:  ToDouble") {
+  REQUIRE(BigInteger(-3).ToDouble() == -3.0);
+  REQUIRE(std::isnan(BigInteger::Error().ToDouble()));
+  // 2^53 + 1 is a tie (even)
+  REQUIRE(BigInteger::Parse("9007199254740993").ToDouble() ==
+          9007199254740992.0);
+  // beyond 64 bits: tie on 2^70 + 2^17, above it with one more unit
+  REQUIRE(BigInteger::Parse("400000000000020000", 16).ToDouble() ==
+          std::ldexp(1.0, 70));
+  REQUIRE(BigInteger::Parse("400000000000020001", 16).ToDouble() ==
+          std::ldexp(1.0, 70) + std::ldexp(1.0, 18));
+  REQUIRE(BigInteger::Parse("-ffffffffffffffff", 16).ToDouble() ==
+          -std::ldexp(1.0, 64));
+  REQUIRE(BigInteger::PowerOf10(22).ToDouble() == 1e22);
+  REQUIRE(BigInteger::PowerOf10(308).ToDouble() == 1e308);
+  REQUIRE((-BigInteger::PowerOf10(300)).ToDouble() == -1e300);
+  REQUIRE(BigInteger::PowerOf10(309).ToDouble() ==
+          std::numeric_limits<double>::infinity());
+}
+
+#ifdef __SIZEOF_INT128__
+TEST_CASE("csBISerializeTests:  ToInt128") {
+  bool overflow = true;
+  REQUIRE(BigInteger(-2).ToInt128(overflow) == -2);
+  REQUIRE(!overflow);
+  BigInteger big = BigInteger::Parse("-7fffffffffffffffffffffffffffffff", 16);
+  cs_int128 v = big.ToInt128(overflow);
+  REQUIRE(!overflow);
+  cs_int128 max128 = static_cast<cs_int128>(~cs_dlimb{0} >> 1);
+  REQUIRE(v == -max128);
+  v = (-big + 2).ToInt128(overflow);  // 2^127 + 1, low bits kept
+  REQUIRE(overflow);
+  REQUIRE(v == -max128);  // two's complement of 2^127 + 1
+  BigInteger::Error().ToInt128(overflow);
+  REQUIRE(overflow);
+}
+#endif
+#endif
+
+#ifndef TEST_CSBIGINTEGER_LIB
+TEST_CASE("csBISerializeTests:  Floating_Point_Exact") {
+  REQUIRE(BigInteger(2.9) == BigInteger(2));
+  REQUIRE(BigInteger(-2.9) == BigInteger(-2));
+  REQUIRE(BigInteger(-0.5) == BigInteger::Zero());
+  REQUIRE(BigInteger(-0.0) == BigInteger::Zero());
+  REQUIRE(BigInteger(256.0f) == BigInteger(256));
+  REQUIRE(BigInteger(1e20) == BigInteger::Parse("100000000000000000000"));
+  REQUIRE(BigInteger(-std::ldexp(1.0, 63)) ==
+          BigInteger(std::numeric_limits<cs_int64>::min()));
+  REQUIRE(BigInteger(std::numeric_limits<float>::max()).ToString(10) ==
+          "340282346638528859811704183484516925440");
+  BigInteger dmax(std::numeric_limits<double>::max());
+  REQUIRE(dmax.ToString(16) ==
+          "0x00" + string(13, 'f') + "8" + string(242, '0'));
+  REQUIRE(dmax.ToDouble() == std::numeric_limits<double>::max());
+  REQUIRE(BigInteger(std::numeric_limits<double>::quiet_NaN()) ==
+          BigInteger::Error());
+  REQUIRE(BigInteger(-std::numeric_limits<double>::infinity()) ==
+          BigInteger::Error());
+  if (std::numeric_limits<long double>::digits >= 64) {
+    long double v = std::ldexp(1.0L, 63) + 1;
+    REQUIRE(BigInteger(v) == BigInteger::Parse("9223372036854775809"));
+  }
+}
+#endif
@@ -0,0 +1,105 @@
+#include <catch2/catch_amalgamated.hpp>
+
+// core includes
+#ifdef TEST_CSBIGINTEGER_LIB
+#include <csbiginteger/csBigIntegerLibClass.hpp>
+using namespace csbigintegerlib;
+#else
+#include <csbiginteger/BigInteger.h>
+#include <csbiginteger/BigIntegerShifted.hpp>
+using namespace csbiginteger;
+#endif
+
+using namespace std;
+
+#ifndef TEST_CSBIGINTEGER_LIB
+
+TEST_CASE("csBIShiftedTests:  BitLength_And_TrailingZeroCount") {
+  REQUIRE(BigInteger::Zero().GetBitLength() == 0);
+  REQUIRE(BigInteger::One().GetBitLength() == 1);
+  REQUIRE(BigInteger::MinusOne().GetBitLength() == 0);
+  REQUIRE(BigInteger(255).GetBitLength() == 8);
+  REQUIRE(BigInteger(256).GetBitLength() == 9);
+  REQUIRE(BigInteger(-128).GetBitLength() == 7);
+  REQUIRE(BigInteger(-129).GetBitLength() == 8);
+  REQUIRE((BigInteger::One() << 1000).GetBitLength() == 1001);
+  REQUIRE(BigInteger::Zero().TrailingZeroCount() == 0);
+  REQUIRE(BigInteger(-1).TrailingZeroCount() == 0);
+  REQUIRE(BigInteger(-1024).TrailingZeroCount() == 10);
+  REQUIRE((BigInteger(3) << 999).TrailingZeroCount() == 999);
+  REQUIRE(BigInteger::Error().GetBitLength() == 0);
+}
+
+TEST_CASE("csBIShiftedTests:  Matches_BigInteger") {
+  BigInteger vals[] = {BigInteger::Zero(), BigInteger(1),    BigInteger(-1),
+                       BigInteger(12),     BigInteger(-40),  BigInteger(255),
+                       BigInteger(-256),   BigInteger(1001), BigInteger(-77)};
+  for (const BigInteger& a : vals) {
+    for (const BigInteger& b : vals) {
+      for (int s = 0; s < 20; s += 3) {
+        BigIntegerShifted sa = BigIntegerShifted(a) << s;
+        BigIntegerShifted sb = BigIntegerShifted(b) << (20 - s);
+        BigInteger xa = a << s;
+        BigInteger xb = b << (20 - s);
+        REQUIRE(sa.ToBigInteger() == xa);
+        REQUIRE(sa.GetBitLength() == xa.GetBitLength());
+        REQUIRE((sa >> 7).ToBigInteger() == (xa >> 7));
+        REQUIRE((sa + sb).ToBigInteger() == xa + xb);
+        REQUIRE((sa - sb).ToBigInteger() == xa - xb);
+        REQUIRE((sa * sb).ToBigInteger() == xa * xb);
+        REQUIRE((sa < sb) == (xa < xb));
+        REQUIRE((sa > sb) == (xa > xb));
+        REQUIRE((sa == sb) == (xa == xb));
+      }
+    }
+  }
+}
+
+TEST_CASE("csBIShiftedTests:  Large_Shifts_Stay_Lazy") {
+  BigInteger x("123456789012345678901234567891", 10);  // odd
+  BigIntegerShifted s = BigIntegerShifted(x) << 4000000000LL;
+  REQUIRE(s.Mantissa() == x);
+  REQUIRE(s.Exponent() == 4000000000LL);
+  REQUIRE(s.GetBitLength() == x.GetBitLength() + 4000000000LL);
+  REQUIRE(((s >> 4000000000LL).ToBigInteger()) == x);
+  REQUIRE((s >> 3999999990LL).ToBigInteger() == (x << 10));
+  REQUIRE((s >> 4000000010LL).ToBigInteger() == (x >> 10));
+  // products and comparisons without materialization
+  BigIntegerShifted p = s * (BigIntegerShifted(BigInteger(6)) << 100);
+  REQUIRE(p.Mantissa() == x * BigInteger(3));
+  REQUIRE(p.Exponent() == 4000000101LL);
+  REQUIRE(p > s);
+  REQUIRE(-p < -s);
+  REQUIRE(s > (BigIntegerShifted(x - BigInteger::One()) << 4000000000LL));
+  REQUIRE(s < (BigIntegerShifted(x + BigInteger::One()) << 4000000000LL));
+  REQUIRE(s == (BigIntegerShifted(x << 3) << 3999999997LL));
+  REQUIRE((s - s).IsZero());
+  REQUIRE(BigIntegerShifted(BigInteger::Error()).IsError());
+  REQUIRE((s * BigIntegerShifted::Error()).IsError());
+}
+
+TEST_CASE("csBIShiftedTests:  Shifts_Beyond_Int32") {
+  // engine shifts take int32 counts: no silent truncation
+  BigInteger x(-77);
+  BigIntegerShifted s = BigIntegerShifted(x) << 2147483653LL;  // 2^31 + 5
+  REQUIRE(s.ToBigInteger().IsError());
+  REQUIRE((BigIntegerShifted(x) << 4294967298LL).ToBigInteger().IsError());
+  REQUIRE((s >> 2147483650LL).ToBigInteger() == (x << 3));
+  REQUIRE((s >> 4294967296LL).ToBigInteger() == BigInteger::MinusOne());
+  REQUIRE((-s >> 4294967296LL).ToBigInteger() == BigInteger::Zero());
+  REQUIRE((BigIntegerShifted(x) >> 4294967297LL).ToBigInteger() ==
+          BigInteger::MinusOne());
+  REQUIRE((BigIntegerShifted(BigInteger(7)) >> 4294967297LL).ToBigInteger() ==
+          BigInteger::Zero());
+  // sums: exponents more than 2^31 apart cannot be aligned
+  BigIntegerShifted one(BigInteger::One());
+  REQUIRE((s + one).IsError());
+  REQUIRE((one - s).IsError());
+  REQUIRE(!((s << 1) + s).IsError());  // aligned by a single bit
+  REQUIRE(((s << 1) + s).Mantissa() == x * BigInteger(3));
+  REQUIRE((s - s).IsZero());
+  REQUIRE(((one << 3000000000LL) + (one << 3000000010LL)).Exponent() ==
+          3000000000LL);
+}
+
+#endif
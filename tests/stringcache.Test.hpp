@@ -0,0 +1,110 @@
+#include <catch2/catch_amalgamated.hpp>
+
+// system
+#include <thread>
+#include <vector>
+
+// core includes
+#ifdef TEST_CSBIGINTEGER_LIB
+#include <csbiginteger/csBigIntegerLibClass.hpp>
+using namespace csbigintegerlib;
+#else
+#include <csbiginteger/BigInteger.h>
+#include <csbiginteger/BigIntegerStringCache.hpp>
+using namespace csbiginteger;
+#endif
+
+using namespace std;
+
+#ifndef TEST_CSBIGINTEGER_LIB
+
+TEST_CASE("csBIStringCacheTests:  Disabled_By_Default") {
+  REQUIRE(BigIntegerStringCache::Budget() == 0);
+  BigInteger big = BigInteger::PowerOf10(300) + BigInteger(7);
+  string s = big.ToString(10);
+  REQUIRE(big.ToString(10) == s);
+  BigIntegerStringCache::Stats st = BigIntegerStringCache::GetStats();
+  REQUIRE(st.entries == 0);
+  REQUIRE(st.hits + st.misses == 0);
+}
+
+TEST_CASE("csBIStringCacheTests:  Hits_And_Mutation") {
+  BigIntegerStringCache::Clear();
+  BigIntegerStringCache::SetBudget(size_t{1} << 20);
+  BigInteger big = BigInteger::PowerOf10(300) + BigInteger(7);
+  string s = "1" + string(297, '0') + "007";
+  REQUIRE(big.ToString(10) == s);
+  REQUIRE(big.ToString(10) == s);
+  REQUIRE(big.ToString(10) == s);
+  REQUIRE(big.ToString(58) == big.ToString(58));
+  REQUIRE(big.ToString(16) == big.ToString(16));  // not cached
+  BigIntegerStringCache::Stats st = BigIntegerStringCache::GetStats();
+  REQUIRE(st.hits == 3);
+  REQUIRE(st.misses == 2);
+  REQUIRE(st.entries == 2);
+  // mutated value is another key
+  big = big + BigInteger::One();
+  REQUIRE(big.ToString(10) == "1" + string(297, '0') + "008");
+  REQUIRE(-big == BigInteger::Parse("-" + big.ToString(10)));
+  // small values bypass cache
+  REQUIRE(BigInteger(12345).ToString(10) == "12345");
+  st = BigIntegerStringCache::GetStats();
+  REQUIRE(st.hits == 4);
+  REQUIRE(st.entries == 3);
+  BigIntegerStringCache::SetBudget(0);
+  REQUIRE(BigIntegerStringCache::GetStats().entries == 0);
+  BigIntegerStringCache::Clear();
+}
+
+TEST_CASE("csBIStringCacheTests:  Budget_And_LRU") {
+  BigIntegerStringCache::Clear();
+  BigIntegerStringCache::SetBudget(4000);
+  vector<BigInteger> vals;
+  for (int i = 0; i < 20; i++)
+    vals.push_back(BigInteger::PowerOf10(400) + BigInteger(i));
+  vals[0].ToString(10);
+  for (int i = 1; i < 20; i++) {
+    vals[0].ToString(10);  // keeps first entry recent
+    vals[i].ToString(10);
+    REQUIRE(BigIntegerStringCache::GetStats().bytes <= 4000);
+  }
+  BigIntegerStringCache::Stats st = BigIntegerStringCache::GetStats();
+  REQUIRE(st.evictions > 0);
+  REQUIRE(st.entries < 20);
+  size_t hits = st.hits;
+  vals[0].ToString(10);
+  REQUIRE(BigIntegerStringCache::GetStats().hits == hits + 1);
+  vals[1].ToString(10);  // evicted
+  REQUIRE(BigIntegerStringCache::GetStats().hits == hits + 1);
+  BigIntegerStringCache::SetBudget(0);
+  BigIntegerStringCache::Clear();
+}
+
+TEST_CASE("csBIStringCacheTests:  Shared_By_Threads") {
+  BigIntegerStringCache::Clear();
+  BigIntegerStringCache::SetBudget(size_t{1} << 20);
+  vector<BigInteger> vals;
+  vector<string> expected;
+  for (int i = 0; i < 8; i++) {
+    vals.push_back(BigInteger::PowerOf10(200 + i) - BigInteger::One());
+    expected.push_back(string(200 + i, '9'));
+  }
+  vector<int> ok(4, 0);
+  vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&, t]() {
+      for (int r = 0; r < 50; r++)
+        for (int i = 0; i < 8; i++)
+          ok[t] += (vals[i].ToString(10) == expected[i]);
+    });
+  }
+  for (std::thread& th : threads) th.join();
+  for (int t = 0; t < 4; t++) REQUIRE(ok[t] == 400);
+  BigIntegerStringCache::Stats st = BigIntegerStringCache::GetStats();
+  REQUIRE(st.entries == 8);
+  REQUIRE(st.hits + st.misses == 1600);
+  BigIntegerStringCache::SetBudget(0);
+  BigIntegerStringCache::Clear();
+}
+
+#endif